@@ -35,6 +35,7 @@
 #include <ql/time/schedule.hpp>
 #include <ql/instruments/vanillaswap.hpp>
 #include <ql/functional.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -63,6 +64,32 @@ namespace QuantLib {
             forwardValue_, std::sqrt(variance));
     }
 
+    namespace {
+
+        // keeps the undeflated prices returned by the underlying pricer
+        class CachedVanillaOptionPricer : public VanillaOptionPricer {
+          public:
+            explicit CachedVanillaOptionPricer(
+                       const ext::shared_ptr<VanillaOptionPricer>& pricer)
+            : pricer_(pricer) {}
+            Real operator()(Real strike,
+                            Option::Type optionType,
+                            Real deflator) const {
+                std::pair<Real, Option::Type> key(strike, optionType);
+                std::map<std::pair<Real, Option::Type>, Real>::const_iterator
+                    i = prices_.find(key);
+                if (i == prices_.end())
+                    i = prices_.insert(std::make_pair(
+                            key, (*pricer_)(strike, optionType, 1.0))).first;
+                return deflator * i->second;
+            }
+          private:
+            ext::shared_ptr<VanillaOptionPricer> pricer_;
+            mutable std::map<std::pair<Real, Option::Type>, Real> prices_;
+        };
+
+    }
+
 
 //===========================================================================//
 //                             HaganPricer                               //
@@ -74,11 +101,90 @@ namespace QuantLib {
     : CmsCouponPricer(swaptionVol),
       modelOfYieldCurve_(modelOfYieldCurve),
       cutoffForCaplet_(2), cutoffForFloorlet_(0),
-      meanReversion_(meanReversion) {
+      meanReversion_(meanReversion), replication_(0),
+      replicationCaching_(false) {
           registerWith(meanReversion_);
     }
 
+    bool HaganPricer::ReplicationKey::operator<(
+                                    const ReplicationKey& other) const {
+        if (fixingDate != other.fixingDate)
+            return fixingDate < other.fixingDate;
+        if (swapUnits != other.swapUnits)
+            return swapUnits < other.swapUnits;
+        if (swapLength != other.swapLength)
+            return swapLength < other.swapLength;
+        if (swapRateValue != other.swapRateValue)
+            return swapRateValue < other.swapRateValue;
+        return annuity < other.annuity;
+    }
+
+    bool HaganPricer::OptionletKey::operator<(
+                                    const OptionletKey& other) const {
+        if (paymentDate != other.paymentDate)
+            return paymentDate < other.paymentDate;
+        if (optionType != other.optionType)
+            return optionType < other.optionType;
+        return strike < other.strike;
+    }
+
+    void HaganPricer::enableReplicationCaching(bool b) {
+        replicationCaching_ = b;
+        if (!b) {
+            replicationCache_.clear();
+            replication_ = 0;
+        }
+    }
+
+    void HaganPricer::disableReplicationCaching() {
+        enableReplicationCaching(false);
+    }
+
+    bool HaganPricer::allowsReplicationCaching() const {
+        return replicationCaching_;
+    }
+
+    void HaganPricer::update() {
+        replicationCache_.clear();
+        replication_ = 0;
+        CmsCouponPricer::update();
+    }
+
+    std::vector<Rate> HaganPricer::swapletRates(const Leg& leg) {
+        std::vector<Rate> rates(leg.size(), Null<Rate>());
+        std::vector<std::pair<Date, Size> > fixings;
+        for (Size i=0; i<leg.size(); ++i) {
+            ext::shared_ptr<CmsCoupon> c =
+                ext::dynamic_pointer_cast<CmsCoupon>(leg[i]);
+            if (c)
+                fixings.push_back(std::make_pair(c->fixingDate(), i));
+        }
+        std::sort(fixings.begin(), fixings.end());
+
+        // unless caching was enabled by the user, only the replication
+        // of the current fixing date is kept
+        const bool caching = replicationCaching_;
+        replicationCaching_ = true;
+        try {
+            for (Size k=0; k<fixings.size(); ++k) {
+                if (!caching && k > 0 && fixings[k].first != fixings[k-1].first) {
+                    replicationCache_.clear();
+                    replication_ = 0;
+                }
+                const Size i = fixings[k].second;
+                initialize(*ext::dynamic_pointer_cast<CmsCoupon>(leg[i]));
+                rates[i] = swapletRate();
+            }
+        } catch (...) {
+            enableReplicationCaching(caching);
+            throw;
+        }
+        enableReplicationCaching(caching);
+        return rates;
+    }
+
     void HaganPricer::initialize(const FloatingRateCoupon& coupon){
+        replication_ = 0;
         coupon_ =  dynamic_cast<const CmsCoupon*>(&coupon);
         QL_REQUIRE(coupon_, "CMS coupon needed");
         gearing_ = coupon_->gearing();
@@ -138,9 +244,36 @@ namespace QuantLib {
                 default:
                     QL_FAIL("unknown/illegal gFunction type");
             }
-            vanillaOptionPricer_= ext::shared_ptr<VanillaOptionPricer>(new
-                BlackVanillaOptionPricer(swapRateValue_, fixingDate_, swapTenor_,
-                                        *swaptionVolatility()));
+            if (replicationCaching_) {
+                if (today != replicationDate_) {
+                    replicationCache_.clear();
+                    replicationDate_ = today;
+                }
+                ReplicationKey key = { fixingDate_, swapTenor_.length(),
+                                       swapTenor_.units(), swapRateValue_,
+                                       annuity_ };
+                std::map<ReplicationKey, Replication>::iterator i =
+                    replicationCache_.find(key);
+                if (i == replicationCache_.end()) {
+                    // entries for previous curves are never used again
+                    if (replicationCache_.size() >= maxReplications)
+                        replicationCache_.clear();
+                    i = replicationCache_.insert(
+                            std::make_pair(key, Replication())).first;
+                    ext::shared_ptr<VanillaOptionPricer> pricer(new
+                        BlackVanillaOptionPricer(swapRateValue_, fixingDate_,
+                                                 swapTenor_,
+                                                 *swaptionVolatility()));
+                    i->second.vanillaOptionPricer =
+                        ext::make_shared<CachedVanillaOptionPricer>(pricer);
+                }
+                replication_ = &i->second;
+                vanillaOptionPricer_ = replication_->vanillaOptionPricer;
+            } else {
+                vanillaOptionPricer_= ext::shared_ptr<VanillaOptionPricer>(new
+                    BlackVanillaOptionPricer(swapRateValue_, fixingDate_, swapTenor_,
+                                            *swaptionVolatility()));
+            }
          }
     }
 
@@ -319,6 +452,17 @@ namespace QuantLib {
     Real NumericHaganPricer::optionletPrice(
                                 Option::Type optionType, Real strike) const {
 
+        // the replicated value only depends on the payment date through
+        // the G function; accrual and discounting are applied below
+        OptionletKey key = { paymentDate_, optionType, strike };
+        if (replication_ != 0) {
+            std::map<OptionletKey, Real>::const_iterator i =
+                replication_->optionlets.find(key);
+            if (i != replication_->optionlets.end())
+                return coupon_->accrualPeriod() * (discount_/annuity_) *
+                    i->second;
+        }
+
         ext::shared_ptr<ConundrumIntegrand> integrand(new
             ConundrumIntegrand(vanillaOptionPricer_, rateCurve_, gFunction_,
                                fixingDate_, paymentDate_, annuity_,
@@ -344,8 +488,12 @@ namespace QuantLib {
             (*vanillaOptionPricer_)(strike, optionType, annuity_);
 
         // v. HAGAN, Conundrums..., formule 2.17a, 2.18a
+        Real replicatedValue =
+            (1 + dFdK) * swaptionPrice + optionType*integralValue;
+        if (replication_ != 0)
+            replication_->optionlets[key] = replicatedValue;
         return coupon_->accrualPeriod() * (discount_/annuity_) *
-            ((1 + dFdK) * swaptionPrice + optionType*integralValue);
+            replicatedValue;
     }
 
     Real NumericHaganPricer::swapletPrice() const {
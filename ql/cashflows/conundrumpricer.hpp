@@ -25,6 +25,7 @@
 
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -213,6 +214,32 @@ namespace QuantLib {
             registerWith(meanReversion_);
             update();
         };
+        /*! When replication caching is enabled, coupons with the same
+            fixing date and underlying swap (tenor, fair rate and
+            annuity) share the vanilla swaption prices used by the
+            replication, and coupons that also have the same payment
+            date reuse the replicated optionlets, so that only their
+            accrual and discounting are recalculated.  The cache is
+            cleared when the pricer is notified of a change in the
+            volatility or in the mean reversion and when the
+            evaluation date changes; it is also cleared when full,
+            so that entries for previous curves are eventually
+            discarded.
+        */
+        void enableReplicationCaching(bool b = true);
+        void disableReplicationCaching();
+        bool allowsReplicationCaching() const;
+        //! swaplet rates of the CMS coupons in the leg
+        /*! The coupons are priced by this pricer, regardless of the
+            one they were given, one fixing date at a time and sharing
+            the replication among the coupons with the same fixing.
+            Null<Rate>() is returned for the other cash flows.
+        */
+        std::vector<Rate> swapletRates(const Leg& leg);
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
       protected:
         HaganPricer(
                 const Handle<SwaptionVolatilityStructure>& swaptionVol,
@@ -238,6 +265,32 @@ namespace QuantLib {
         Handle<Quote> meanReversion_;
         Period swapTenor_;
         ext::shared_ptr<VanillaOptionPricer> vanillaOptionPricer_;
+
+        struct ReplicationKey {
+            Date fixingDate;
+            Integer swapLength;
+            TimeUnit swapUnits;
+            Rate swapRateValue;
+            Real annuity;
+            bool operator<(const ReplicationKey& other) const;
+        };
+        struct OptionletKey {
+            Date paymentDate;
+            Option::Type optionType;
+            Rate strike;
+            bool operator<(const OptionletKey& other) const;
+        };
+        struct Replication {
+            ext::shared_ptr<VanillaOptionPricer> vanillaOptionPricer;
+            std::map<OptionletKey, Real> optionlets;
+        };
+        //! cached replication for the current coupon, if any
+        Replication* replication_;
+      private:
+        static const Size maxReplications = 1000;
+        bool replicationCaching_;
+        std::map<ReplicationKey, Replication> replicationCache_;
+        Date replicationDate_;
     };
 
 
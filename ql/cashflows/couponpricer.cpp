@@ -65,6 +65,7 @@ namespace QuantLib {
         spreadLegValue_ = spread_ * accrualPeriod_ * discount_;
 
         coupon_ = &coupon;
+        iborCoupon_ = dynamic_cast<const IborCoupon*>(&coupon);
     }
 
     Real BlackIborCouponPricer::optionletPrice(Option::Type optionType,
@@ -114,8 +115,14 @@ namespace QuantLib {
         if ((!coupon_->isInArrears() && timingAdjustment_ == Black76))
             return fixing;
         Date d1 = coupon_->fixingDate();
-        Date d2 = index_->valueDate(d1);
-        Date d3 = index_->maturityDate(d2);
+        Date d2, d3;
+        if (iborCoupon_ != 0) {
+            d2 = iborCoupon_->fixingValueDate();
+            d3 = iborCoupon_->fixingMaturityDate();
+        } else {
+            d2 = index_->valueDate(d1);
+            d3 = index_->maturityDate(d2);
+        }
         if (coupon_->date() == d3)
             return fixing;
 
@@ -125,7 +132,9 @@ namespace QuantLib {
         // no variance has accumulated, so the convexity is zero
         if (d1 <= referenceDate)
             return fixing;
-        Time tau = index_->dayCounter().yearFraction(d2, d3);
+        Time tau = iborCoupon_ != 0 ?
+            iborCoupon_->spanningTimeIndexMaturity() :
+            index_->dayCounter().yearFraction(d2, d3);
         Real variance = capletVolatility()->blackVariance(d1, fixing);
 
         Real shift = capletVolatility()->displacement();
@@ -99,7 +99,8 @@ namespace QuantLib {
             const TimingAdjustment timingAdjustment = Black76,
             const Handle<Quote> correlation =
                 Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(1.0))))
-            : IborCouponPricer(v), timingAdjustment_(timingAdjustment),
+            : IborCouponPricer(v), coupon_(0), iborCoupon_(0),
+              timingAdjustment_(timingAdjustment),
               correlation_(correlation) {
             QL_REQUIRE(timingAdjustment_ == Black76 ||
                            timingAdjustment_ == BivariateLognormal,
@@ -129,6 +130,9 @@ namespace QuantLib {
         Real spreadLegValue_;
 
         const FloatingRateCoupon* coupon_;
+        // non-null if coupon_ is an IborCoupon, whose estimation
+        // dates can then be used instead of being recalculated
+        const IborCoupon* iborCoupon_;
 
       private:
         const TimingAdjustment timingAdjustment_;
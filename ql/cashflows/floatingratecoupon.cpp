@@ -24,6 +24,7 @@
 
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/indexes/interestrateindex.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
 
@@ -68,6 +69,17 @@ namespace QuantLib {
         update();
     }
 
+    void FloatingRateCoupon::registerWithFixings(
+                                    const std::vector<Date>& fixingDates,
+                                    const Handle<YieldTermStructure>& curve) {
+        unregisterWith(index_);
+        registerWith(curve);
+        const std::string name = index_->name();
+        for (Size i=0; i<fixingDates.size(); ++i)
+            registerWith(IndexManager::instance().notifier(name,
+                                                           fixingDates[i]));
+    }
+
     Real FloatingRateCoupon::accruedAmount(const Date& d) const {
         if (d <= accrualStartDate_ || d > paymentDate_) {
             return 0.0;
@@ -108,6 +108,16 @@ namespace QuantLib {
       protected:
         //! convexity adjustment for the given index fixing
         Rate convexityAdjustmentImpl(Rate fixing) const;
+        /*! Replaces the registration with the index by registrations
+            with the given forecast curve and with the notifiers of
+            the given fixings in the IndexManager.  This way, the
+            coupon is not notified when other fixings of the index
+            are added.  Derived classes can call it when the index
+            has no other dependencies, i.e., when the index allows
+            per-fixing notifications.
+        */
+        void registerWithFixings(const std::vector<Date>& fixingDates,
+                                 const Handle<YieldTermStructure>& curve);
         ext::shared_ptr<InterestRateIndex> index_;
         DayCounter dayCounter_;
         Natural fixingDays_;
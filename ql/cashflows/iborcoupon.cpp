@@ -27,6 +27,8 @@
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/indexes/interestrateindex.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
+#include <map>
 
 namespace QuantLib {
 
@@ -78,9 +80,11 @@ namespace QuantLib {
         fixingValueDate_ = fixingCalendar.advance(
             fixingDate_, indexFixingDays, Days);
 
+        fixingMaturityDate_ = index_->maturityDate(fixingValueDate_);
+
         if (usingAtParCoupons_) {
             if (isInArrears_)
-                fixingEndDate_ = index_->maturityDate(fixingValueDate_);
+                fixingEndDate_ = fixingMaturityDate_;
             else { // par coupon approximation
                 Date nextFixingDate = fixingCalendar.advance(
                     accrualEndDate_, -static_cast<Integer>(fixingDays_), Days);
@@ -90,7 +94,7 @@ namespace QuantLib {
                 fixingEndDate_ = std::max(fixingEndDate_, fixingValueDate_ + 1);
             }
         } else {
-            fixingEndDate_ = index_->maturityDate(fixingValueDate_);
+            fixingEndDate_ = fixingMaturityDate_;
         }
 
         const DayCounter& dc = index_->dayCounter();
@@ -101,6 +105,15 @@ namespace QuantLib {
                    fixingValueDate_ << " and " << fixingEndDate_ <<
                    ":\n non positive time (" << spanningTime_ <<
                    ") using " << dc.name() << " daycounter");
+        spanningTimeIndexMaturity_ =
+            fixingEndDate_ == fixingMaturityDate_ ?
+            spanningTime_ :
+            dc.yearFraction(fixingValueDate_, fixingMaturityDate_);
+
+        if (iborIndex_->allowsPerFixingNotifications() &&
+            !iborIndex_->forwardingTermStructure().empty())
+            registerWithFixings(std::vector<Date>(1, fixingDate_),
+                                iborIndex_->forwardingTermStructure());
     }
 
     Rate IborCoupon::indexFixing() const {
@@ -152,6 +165,71 @@ namespace QuantLib {
 
 
 
+    std::vector<Rate> iborFixings(const Leg& leg) {
+
+        std::vector<Rate> fixings(leg.size(), Null<Rate>());
+        Date today = Settings::instance().evaluationDate();
+
+        // coupons to be forecast, grouped by forwarding curve
+        typedef std::map<const YieldTermStructure*, std::vector<Size> >
+                                                                   curve_map;
+        curve_map forecast;
+        for (Size i=0; i<leg.size(); ++i) {
+            const IborCoupon* c =
+                dynamic_cast<const IborCoupon*>(leg[i].get());
+            if (c == 0)
+                continue;
+            if (c->fixingDate() > today) {
+                const Handle<YieldTermStructure>& h =
+                    c->iborIndex()->forwardingTermStructure();
+                QL_REQUIRE(!h.empty(),
+                           "null term structure set to this instance of "
+                           << c->iborIndex()->name());
+                forecast[h.currentLink().get()].push_back(i);
+            } else {
+                fixings[i] = c->indexFixing();
+            }
+        }
+
+        std::vector<Date> dates;
+        std::vector<DiscountFactor> discounts;
+        for (curve_map::const_iterator g = forecast.begin();
+             g != forecast.end(); ++g) {
+            const std::vector<Size>& coupons = g->second;
+            dates.clear();
+            for (Size j=0; j<coupons.size(); ++j) {
+                const IborCoupon& c =
+                    static_cast<const IborCoupon&>(*leg[coupons[j]]);
+                dates.push_back(c.fixingValueDate());
+                dates.push_back(c.fixingEndDate());
+            }
+            std::sort(dates.begin(), dates.end());
+            dates.erase(std::unique(dates.begin(), dates.end()),
+                        dates.end());
+
+            discounts.resize(dates.size());
+            for (Size k=0; k<dates.size(); ++k)
+                discounts[k] = g->first->discount(dates[k]);
+
+            for (Size j=0; j<coupons.size(); ++j) {
+                const IborCoupon& c =
+                    static_cast<const IborCoupon&>(*leg[coupons[j]]);
+                DiscountFactor disc1 = discounts[
+                    std::lower_bound(dates.begin(), dates.end(),
+                                     c.fixingValueDate()) - dates.begin()];
+                DiscountFactor disc2 = discounts[
+                    std::lower_bound(dates.begin(), dates.end(),
+                                     c.fixingEndDate()) - dates.begin()];
+                fixings[coupons[j]] =
+                    (disc1/disc2 - 1.0) / c.spanningTime();
+            }
+        }
+
+        return fixings;
+    }
+
+
+
     IborLeg::IborLeg(const Schedule& schedule,
                      const ext::shared_ptr<IborIndex>& index)
     : schedule_(schedule), index_(index),
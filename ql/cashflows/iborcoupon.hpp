@@ -36,6 +36,12 @@
 namespace QuantLib {
 
     //! %Coupon paying a Libor-type index
+    /*! \note If the index allows per-fixing notifications, the
+              coupon is notified of changes in the fixing at its
+              fixing date and in the forecast curve of the index; it
+              is not notified when other fixings are added.
+              Otherwise, it observes the index as a whole.
+    */
     class IborCoupon : public FloatingRateCoupon {
       public:
         IborCoupon(const Date& paymentDate,
@@ -54,8 +60,19 @@ namespace QuantLib {
         //! \name Inspectors
         //@{
         const ext::shared_ptr<IborIndex>& iborIndex() const { return iborIndex_; }
-        //! this is dependent on usingAtParCoupons()
+        //! start of the index estimation period
+        const Date& fixingValueDate() const { return fixingValueDate_; }
+        //! end of the index estimation period
+        /*! this is dependent on usingAtParCoupons() */
         const Date& fixingEndDate() const { return fixingEndDate_; }
+        //! maturity of the index tenor starting at the fixing value date
+        const Date& fixingMaturityDate() const { return fixingMaturityDate_; }
+        //! index day-count fraction of the estimation period
+        Time spanningTime() const { return spanningTime_; }
+        //! index day-count fraction of the index tenor
+        Time spanningTimeIndexMaturity() const {
+            return spanningTimeIndexMaturity_;
+        }
         //@}
         //! \name FloatingRateCoupon interface
         //@{
@@ -68,8 +85,9 @@ namespace QuantLib {
         //@}
       private:
         ext::shared_ptr<IborIndex> iborIndex_;
-        Date fixingDate_, fixingValueDate_, fixingEndDate_;
-        Time spanningTime_;
+        Date fixingDate_, fixingValueDate_, fixingEndDate_,
+             fixingMaturityDate_;
+        Time spanningTime_, spanningTimeIndexMaturity_;
 
       public:
         /*! When called, IborCoupons are created as indexed coupons instead of par coupons. This
@@ -94,6 +112,23 @@ namespace QuantLib {
     };
 
 
+    //! index fixings of the Ibor coupons in a leg
+    /*! Returns a vector with one element per cash flow in the leg;
+        the element equals the result of indexFixing() for Ibor
+        coupons and is null for any other cash flow.
+
+        Fixings not yet determined are forecast together: the
+        estimation dates of all such coupons are collected, the
+        forwarding curve is asked for the discount at each distinct
+        date only once, and the forward rates are obtained from the
+        stored start and end dates and spanning times of the
+        coupons.  When, as is usual, the estimation period of a
+        coupon ends where the one of the next begins, this halves
+        the number of calls to the curve.
+    */
+    std::vector<Rate> iborFixings(const Leg& leg);
+
+
     //! helper class building a sequence of capped/floored ibor-rate coupons
     class IborLeg {
       public:
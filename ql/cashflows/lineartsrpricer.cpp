@@ -34,15 +34,18 @@
 #include <ql/math/integrals/kronrodintegral.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/termstructures/volatility/atmsmilesection.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
     class LinearTsrPricer::integrand_f {
         const LinearTsrPricer* pricer;
+        const Real factor;
       public:
-        explicit integrand_f(const LinearTsrPricer* pricer) : pricer(pricer) {}
+        integrand_f(const LinearTsrPricer* pricer, Real factor)
+        : pricer(pricer), factor(factor) {}
         Real operator()(Real x) const {
-            return pricer->integrand(x);
+            return pricer->integrand(x, factor);
         }
     };
 
@@ -57,7 +60,8 @@ namespace QuantLib {
         const ext::shared_ptr<Integrator> &integrator)
         : CmsCouponPricer(swaptionVol), meanReversion_(meanReversion),
           couponDiscountCurve_(couponDiscountCurve), settings_(settings),
-          volDayCounter_(swaptionVol->dayCounter()), integrator_(integrator) {
+          volDayCounter_(swaptionVol->dayCounter()), integrator_(integrator),
+          replicationCaching_(false), replication_(0) {
 
         if (!couponDiscountCurve_.empty())
             registerWith(couponDiscountCurve_);
@@ -67,6 +71,82 @@ namespace QuantLib {
                 ext::make_shared<GaussKronrodNonAdaptive>(1E-10, 5000, 1E-10);
     }
 
+    bool LinearTsrPricer::ReplicationKey::operator<(
+                                    const ReplicationKey &other) const {
+        if (fixingDate != other.fixingDate)
+            return fixingDate < other.fixingDate;
+        if (swapUnits != other.swapUnits)
+            return swapUnits < other.swapUnits;
+        if (swapLength != other.swapLength)
+            return swapLength < other.swapLength;
+        return swapRateValue < other.swapRateValue;
+    }
+
+    bool LinearTsrPricer::OptionletKey::operator<(
+                                    const OptionletKey &other) const {
+        if (optionType != other.optionType)
+            return optionType < other.optionType;
+        if (strike != other.strike)
+            return strike < other.strike;
+        return slope < other.slope;
+    }
+
+    void LinearTsrPricer::enableReplicationCaching(bool b) {
+        replicationCaching_ = b;
+        if (!b) {
+            replicationCache_.clear();
+            replication_ = 0;
+        }
+    }
+
+    void LinearTsrPricer::disableReplicationCaching() {
+        enableReplicationCaching(false);
+    }
+
+    bool LinearTsrPricer::allowsReplicationCaching() const {
+        return replicationCaching_;
+    }
+
+    void LinearTsrPricer::update() {
+        replicationCache_.clear();
+        replication_ = 0;
+        CmsCouponPricer::update();
+    }
+
+    std::vector<Rate> LinearTsrPricer::swapletRates(const Leg &leg) {
+        std::vector<Rate> rates(leg.size(), Null<Rate>());
+        std::vector<std::pair<Date, Size> > fixings;
+        for (Size i = 0; i < leg.size(); ++i) {
+            ext::shared_ptr<CmsCoupon> c =
+                ext::dynamic_pointer_cast<CmsCoupon>(leg[i]);
+            if (c)
+                fixings.push_back(std::make_pair(c->fixingDate(), i));
+        }
+        std::sort(fixings.begin(), fixings.end());
+
+        // unless caching was enabled by the user, only the replication
+        // of the current fixing date is kept
+        const bool caching = replicationCaching_;
+        replicationCaching_ = true;
+        try {
+            for (Size k = 0; k < fixings.size(); ++k) {
+                if (!caching && k > 0 &&
+                    fixings[k].first != fixings[k - 1].first) {
+                    replicationCache_.clear();
+                    replication_ = 0;
+                }
+                const Size i = fixings[k].second;
+                initialize(*ext::dynamic_pointer_cast<CmsCoupon>(leg[i]));
+                rates[i] = swapletRate();
+            }
+        } catch (...) {
+            enableReplicationCaching(caching);
+            throw;
+        }
+        enableReplicationCaching(caching);
+        return rates;
+    }
+
     Real LinearTsrPricer::GsrG(const Date &d) const {
 
         Real yf = volDayCounter_.yearFraction(fixingDate_, d);
@@ -78,26 +158,26 @@ namespace QuantLib {
     }
 
     Real LinearTsrPricer::singularTerms(const Option::Type type,
-                                        const Real strike) const {
+                                        const Real strike,
+                                        const Real optionPrice) const {
 
         Real omega = (type == Option::Call ? 1.0 : -1.0);
         Real s1 = std::max(omega * (swapRateValue_ - strike), 0.0) *
                   (a_ * swapRateValue_ + b_);
-        Real s2 = (a_ * strike + b_) *
-                  smileSection_->optionPrice(strike, strike < swapRateValue_
-                                                         ? Option::Put
-                                                         : Option::Call);
+        Real s2 = (a_ * strike + b_) * optionPrice;
         return s1 + s2;
     }
 
-    Real LinearTsrPricer::integrand(const Real strike) const {
-        return 2.0 * a_ * smileSection_->optionPrice(
-                              strike, strike < swapRateValue_ ? Option::Put
-                                                              : Option::Call);
+    Real LinearTsrPricer::integrand(const Real strike,
+                                    const Real factor) const {
+        return factor * smileSection_->optionPrice(
+                            strike, strike < swapRateValue_ ? Option::Put
+                                                            : Option::Call);
     }
 
     void LinearTsrPricer::initialize(const FloatingRateCoupon &coupon) {
 
+        replication_ = 0;
         coupon_ = dynamic_cast<const CmsCoupon *>(&coupon);
         QL_REQUIRE(coupon_, "CMS coupon needed");
         gearing_ = coupon_->gearing();
@@ -141,31 +221,62 @@ namespace QuantLib {
             swapRateValue_ = swap_->fairRate();
             annuity_ = 1.0E4 * std::fabs(swap_->fixedLegBPS());
 
-            ext::shared_ptr<SmileSection> sectionTmp =
-                swaptionVolatility()->smileSection(fixingDate_, swapTenor_);
-
-            adjustedLowerBound_ = settings_.lowerRateBound_;
-            adjustedUpperBound_ = settings_.upperRateBound_;
+            if (replicationCaching_) {
+                if (today_ != replicationDate_) {
+                    replicationCache_.clear();
+                    replicationDate_ = today_;
+                }
+                ReplicationKey key = {fixingDate_, swapTenor_.length(),
+                                      swapTenor_.units(), swapRateValue_};
+                std::map<ReplicationKey, Replication>::iterator i =
+                    replicationCache_.find(key);
+                if (i == replicationCache_.end()) {
+                    // entries for previous curves are never used again
+                    if (replicationCache_.size() >= maxReplications)
+                        replicationCache_.clear();
+                    i = replicationCache_.insert(
+                            std::make_pair(key, Replication())).first;
+                }
+                replication_ = &i->second;
+            }
 
-            if(sectionTmp->volatilityType() == Normal) {
-                // adjust lower bound if it was not set explicitly
-                if(settings_.defaultBounds_)
-                    adjustedLowerBound_ = std::min(adjustedLowerBound_, -adjustedUpperBound_);
+            if (replication_ != 0 && replication_->smileSection) {
+                smileSection_ = replication_->smileSection;
+                adjustedLowerBound_ = replication_->adjustedLowerBound;
+                adjustedUpperBound_ = replication_->adjustedUpperBound;
             } else {
-                // adjust bounds by section's shift
-                adjustedLowerBound_ -= sectionTmp->shift();
-                adjustedUpperBound_ -= sectionTmp->shift();
+                ext::shared_ptr<SmileSection> sectionTmp =
+                    swaptionVolatility()->smileSection(fixingDate_, swapTenor_);
+
+                adjustedLowerBound_ = settings_.lowerRateBound_;
+                adjustedUpperBound_ = settings_.upperRateBound_;
+
+                if(sectionTmp->volatilityType() == Normal) {
+                    // adjust lower bound if it was not set explicitly
+                    if(settings_.defaultBounds_)
+                        adjustedLowerBound_ = std::min(adjustedLowerBound_, -adjustedUpperBound_);
+                } else {
+                    // adjust bounds by section's shift
+                    adjustedLowerBound_ -= sectionTmp->shift();
+                    adjustedUpperBound_ -= sectionTmp->shift();
+                }
+
+                // if the section does not provide an atm level, we enhance it to
+                // have one, no need to exit with an exception ...
+
+                if (sectionTmp->atmLevel() == Null<Real>())
+                    smileSection_ = ext::make_shared<AtmSmileSection>(
+                        sectionTmp, swapRateValue_);
+                else
+                    smileSection_ = sectionTmp;
+
+                if (replication_ != 0) {
+                    replication_->smileSection = smileSection_;
+                    replication_->adjustedLowerBound = adjustedLowerBound_;
+                    replication_->adjustedUpperBound = adjustedUpperBound_;
+                }
             }
 
-            // if the section does not provide an atm level, we enhance it to
-            // have one, no need to exit with an exception ...
-
-            if (sectionTmp->atmLevel() == Null<Real>())
-                smileSection_ = ext::make_shared<AtmSmileSection>(
-                    sectionTmp, swapRateValue_);
-            else
-                smileSection_ = sectionTmp;
-
             // compute linear model's parameters
 
             Real gx = 0.0, gy = 0.0;
@@ -260,6 +371,43 @@ namespace QuantLib {
         if (optionType == Option::Put && strike <= adjustedLowerBound_)
             return 0.0;
 
+        Real result;
+        if (replication_ != 0) {
+            // the slope of the annuity mapping depends on the payment
+            // date and is part of the integrand, so that the integration
+            // is the same as without caching
+            OptionletKey key = {optionType, strike, a_};
+            std::map<OptionletKey, std::pair<Real, Real> >::iterator i =
+                replication_->optionlets.find(key);
+            if (i == replication_->optionlets.end())
+                i = replication_->optionlets
+                        .insert(std::make_pair(
+                            key,
+                            std::make_pair(
+                                smileIntegral(optionType, strike, 2.0 * a_),
+                                smileSection_->optionPrice(
+                                    strike, strike < swapRateValue_
+                                                ? Option::Put
+                                                : Option::Call))))
+                        .first;
+            result = i->second.first +
+                     singularTerms(optionType, strike, i->second.second);
+        } else {
+            result = smileIntegral(optionType, strike, 2.0 * a_) +
+                     singularTerms(optionType, strike,
+                                   smileSection_->optionPrice(
+                                       strike, strike < swapRateValue_
+                                                   ? Option::Put
+                                                   : Option::Call));
+        }
+
+        return annuity_ * result * couponDiscountRatio_ *
+               coupon_->accrualPeriod();
+    }
+
+    Real LinearTsrPricer::smileIntegral(Option::Type optionType,
+                                        Real strike, Real factor) const {
+
         // determine lower or upper integration bound (depending on option type)
 
         Real lower = strike, upper = strike;
@@ -336,21 +484,18 @@ namespace QuantLib {
         if (upper > lower) {
             tmpBound = std::min(upper, swapRateValue_);
             if (tmpBound > lower) {
-                result += (*integrator_)(integrand_f(this),
+                result += (*integrator_)(integrand_f(this, factor),
                                          lower, tmpBound);
             }
             tmpBound = std::max(lower, swapRateValue_);
             if (upper > tmpBound) {
-                result += (*integrator_)(integrand_f(this),
+                result += (*integrator_)(integrand_f(this, factor),
                                          tmpBound, upper);
             }
             result *= (optionType == Option::Call ? 1.0 : -1.0);
         }
 
-        result += singularTerms(optionType, strike);
-
-        return annuity_ * result * couponDiscountRatio_ *
-               coupon_->accrualPeriod();
+        return result;
     }
 
     Real LinearTsrPricer::meanReversion() const { return meanReversion_->value(); }
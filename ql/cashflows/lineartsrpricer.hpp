@@ -29,6 +29,7 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/indexes/swapindex.hpp>
 #include <ql/math/integrals/integral.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -184,13 +185,40 @@ namespace QuantLib {
             registerWith(meanReversion_);
             update();
         }
+        /*! When replication caching is enabled, coupons with the same
+            fixing date, swap tenor and swap rate share the smile
+            section; coupons that also have the same slope of the
+            linear annuity mapping (i.e., the same payment date)
+            share the integrals of the smile over the strikes as
+            well, which are the same as without caching.  The cache
+            is cleared when the pricer is notified of a change in
+            the volatility, the mean reversion or the coupon discount
+            curve and when the evaluation date changes; it is also
+            cleared when full, so that entries for previous curves
+            are eventually discarded.
+        */
+        void enableReplicationCaching(bool b = true);
+        void disableReplicationCaching();
+        bool allowsReplicationCaching() const;
+        //! swaplet rates of the CMS coupons in the leg
+        /*! The coupons are priced by this pricer, regardless of the
+            one they were given, one fixing date at a time and sharing
+            the replication among the coupons with the same fixing.
+            Null<Rate>() is returned for the other cash flows.
+        */
+        std::vector<Rate> swapletRates(const Leg& leg);
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
 
 
       private:
 
         Real GsrG(const Date &d) const;
-        Real singularTerms(const Option::Type type, const Real strike) const;
-        Real integrand(const Real strike) const;
+        Real singularTerms(const Option::Type type, const Real strike,
+                           const Real optionPrice) const;
+        Real integrand(const Real strike, const Real factor) const;
         Real a_, b_;
 
         class integrand_f;
@@ -222,6 +250,8 @@ namespace QuantLib {
 
         void initialize(const FloatingRateCoupon &coupon);
         Real optionletPrice(Option::Type optionType, Real strike) const;
+        Real smileIntegral(Option::Type optionType, Real strike,
+                           Real factor) const;
         Real strikeFromVegaRatio(Real ratio, Option::Type optionType,
                                  Real referenceStrike) const;
         Real strikeFromPrice(Real price, Option::Type optionType,
@@ -250,6 +280,31 @@ namespace QuantLib {
         ext::shared_ptr<Integrator> integrator_;
 
         Real adjustedLowerBound_, adjustedUpperBound_;
+
+        struct ReplicationKey {
+            Date fixingDate;
+            Integer swapLength;
+            TimeUnit swapUnits;
+            Rate swapRateValue;
+            bool operator<(const ReplicationKey &other) const;
+        };
+        struct OptionletKey {
+            Option::Type optionType;
+            Real strike;
+            Real slope;
+            bool operator<(const OptionletKey &other) const;
+        };
+        struct Replication {
+            ext::shared_ptr<SmileSection> smileSection;
+            Real adjustedLowerBound, adjustedUpperBound;
+            // smile integral and option price at the strike
+            std::map<OptionletKey, std::pair<Real, Real> > optionlets;
+        };
+        static const Size maxReplications = 1000;
+        bool replicationCaching_;
+        std::map<ReplicationKey, Replication> replicationCache_;
+        Date replicationDate_;
+        Replication *replication_;
     };
 }
 
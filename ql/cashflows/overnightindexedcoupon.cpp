@@ -54,15 +54,27 @@ namespace QuantLib {
 
                 // already fixed part
                 Date today = Settings::instance().evaluationDate();
-                while (i<n && fixingDates[i]<today) {
-                    // rate must have been fixed
-                    Rate pastFixing = IndexManager::instance().getHistory(
-                                                index->name())[fixingDates[i]];
-                    QL_REQUIRE(pastFixing != Null<Real>(),
-                               "Missing " << index->name() <<
-                               " fixing for " << fixingDates[i]);
-                    compoundFactor *= (1.0 + pastFixing*dt[i]);
+                while (i<n && fixingDates[i]<today)
                     ++i;
+                // the index can usually provide it from its cached
+                // cumulative factors...
+                Real pastFactor = Null<Real>();
+                if (i > 0)
+                    pastFactor = index->compoundFactor(fixingDates[0],
+                                                       fixingDates[i-1], i);
+                if (pastFactor != Null<Real>()) {
+                    compoundFactor = pastFactor;
+                } else {
+                    // ...otherwise we compound the fixings one by one
+                    for (Size j=0; j<i; ++j) {
+                        // rate must have been fixed
+                        Rate pastFixing = IndexManager::instance().getHistory(
+                                                index->name())[fixingDates[j]];
+                        QL_REQUIRE(pastFixing != Null<Real>(),
+                                   "Missing " << index->name() <<
+                                   " fixing for " << fixingDates[j]);
+                        compoundFactor *= (1.0 + pastFixing*dt[j]);
+                    }
                 }
 
                 // today is a border case
@@ -192,6 +204,11 @@ namespace QuantLib {
         for (Size i=0; i<n_; ++i)
             dt_[i] = dc.yearFraction(valueDates_[i], valueDates_[i+1]);
 
+        if (overnightIndex->allowsPerFixingNotifications() &&
+            !overnightIndex->forwardingTermStructure().empty())
+            registerWithFixings(fixingDates_,
+                                overnightIndex->forwardingTermStructure());
+
         setPricer(ext::shared_ptr<FloatingRateCouponPricer>(new
                                             OvernightIndexedCouponPricer));
     }
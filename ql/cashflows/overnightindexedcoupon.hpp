@@ -43,6 +43,12 @@ namespace QuantLib {
         to true unless you know exactly what you are doing. The intended use is
         rather by the OISRateHelper which is safe, since it reinitialises the
         instrument each time the evaluation date changes.
+
+        \note If the index allows per-fixing notifications, the coupon
+              is notified of changes in the fixings at its fixing dates
+              and in the forecast curve of the index; it is not notified
+              when other fixings are added.  Otherwise, it observes the
+              index as a whole.
     */
     class OvernightIndexedCoupon : public FloatingRateCoupon {
       public:
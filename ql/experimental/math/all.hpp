@@ -18,6 +18,7 @@
 #include <ql/experimental/math/moorepenroseinverse.hpp>
 #include <ql/experimental/math/multidimintegrator.hpp>
 #include <ql/experimental/math/multidimquadrature.hpp>
+#include <ql/experimental/math/multistartlevenbergmarquardt.hpp>
 #include <ql/experimental/math/particleswarmoptimization.hpp>
 #include <ql/experimental/math/piecewisefunction.hpp>
 #include <ql/experimental/math/piecewiseintegral.hpp>
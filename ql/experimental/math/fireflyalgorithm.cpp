@@ -62,10 +62,16 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.push_back(std::make_pair(P.value(x), i));
         }
 
+        //Evaluate points
+        Matrix points(M_, N_);
+        for (Size i = 0; i < M_; i++)
+            std::copy(x_[i].begin(), x_[i].end(), points.row_begin(i));
+        Array f = P.batchValue(points);
+        for (Size i = 0; i < M_; i++)
+            values_.push_back(std::make_pair(f[i], i));
+
         //init intensity & randomWalk
         intensity_->init(this);
         randomWalk_->init(this);
@@ -172,29 +178,38 @@ namespace QuantLib {
                 randomWalk_->walk();
 
                 //Loop over particles
+                Matrix zFA(Mfa_, N_);
                 for (Size i = 0; i < Mfa_; i++) {
                     Size index = values_[i].second;
-                    Array& x   = x_[index];
-                    Array& xI  = xI_[index];
-                    Array& xRW = xRW_[index];
+                    const Array& x   = x_[index];
+                    const Array& xI  = xI_[index];
+                    const Array& xRW = xRW_[index];
 
                     //Loop over dimensions
                     for (Size j = 0; j < N_; j++) {
                         //Update position
-                        z[j] = x[j] + xI[j] + xRW[j];
+                        zFA[i][j] = x[j] + xI[j] + xRW[j];
                         //Enforce bounds on positions
-                        if (z[j] < lX_[j]) {
-                            z[j] = lX_[j];
+                        if (zFA[i][j] < lX_[j]) {
+                            zFA[i][j] = lX_[j];
                         }
-                        else if (z[j] > uX_[j]) {
-                            z[j] = uX_[j];
+                        else if (zFA[i][j] > uX_[j]) {
+                            zFA[i][j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
+                }
+
+                //Evaluate the new positions together
+                Array valFA = P.batchValue(zFA);
+
+                for (Size i = 0; i < Mfa_; i++) {
+                    Size index = values_[i].second;
+                    Array& x   = x_[index];
+                    Real val = valFA[i];
                     if(!boost::math::isnan(val))
 					{
 						//Accept new point
-                        x = z;
+                        std::copy(zFA.row_begin(i), zFA.row_end(i), x.begin());
                         values_[index].first = val;
                         //mark best
                         if (val < bestValue) {
@@ -85,6 +85,12 @@ namespace QuantLib {
     \f]
     where C is the crossover constant, and R is a random uniformly distributed
     number.
+
+    The new positions of the firefly subpopulation are evaluated with a single
+    call to CostFunction::batchValue, so that cost functions allowing it can
+    evaluate them concurrently. The DE subpopulation is still evaluated point
+    by point, since each trial point may use the points accepted before it in
+    the same iteration.
     */
     class FireflyAlgorithm : public OptimizationMethod {
       public:
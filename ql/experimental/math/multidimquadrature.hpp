@@ -63,19 +63,21 @@ namespace QuantLib {
             detail::DispArray operator()(const F& f) const {
                 using namespace ext::placeholders;
                 //first one, we do not know the size of the vector returned by f
+                const Array& x = this->x();
+                const Array& w = weights();
                 Integer i = order()-1;
-                std::vector<Real> term = f(x_[i]);// potential copy! @#$%^!!!
+                std::vector<Real> term = f(x[i]);// potential copy! @#$%^!!!
                 std::for_each(term.begin(), term.end(), 
-                              multiply_by<Real>(w_[i]));
+                              multiply_by<Real>(w[i]));
                 std::vector<Real> sum = term;
            
                 for (i--; i >= 0; --i) {
-                    term = f(x_[i]);// potential copy! @#$%^!!!
+                    term = f(x[i]);// potential copy! @#$%^!!!
                     // sum[j] += term[j] * w_[i];
                     std::transform(term.begin(), term.end(), sum.begin(), 
                         sum.begin(), 
                         ext::bind(std::plus<Real>(), _2,
-                            ext::bind(std::multiplies<Real>(), w_[i], _1)));
+                            ext::bind(std::multiplies<Real>(), w[i], _1)));
                 }
                 return sum;
             }
@@ -0,0 +1,139 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/math/multistartlevenbergmarquardt.hpp>
+#include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <string>
+
+namespace QuantLib {
+
+    MultiStartLevenbergMarquardt::MultiStartLevenbergMarquardt(
+                                    const std::vector<Array>& startingPoints,
+                                    Real epsfcn, Real xtol, Real gtol,
+                                    bool useCostFunctionsJacobian)
+    : startingPoints_(startingPoints), additionalStarts_(0), seed_(0),
+      epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
+      useCostFunctionsJacobian_(useCostFunctionsJacobian) {}
+
+    MultiStartLevenbergMarquardt::MultiStartLevenbergMarquardt(
+                                    Size additionalStarts,
+                                    unsigned long seed,
+                                    Real epsfcn, Real xtol, Real gtol,
+                                    bool useCostFunctionsJacobian)
+    : additionalStarts_(additionalStarts), seed_(seed),
+      epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
+      useCostFunctionsJacobian_(useCostFunctionsJacobian) {}
+
+    Disposable<std::vector<Array> >
+    MultiStartLevenbergMarquardt::startingPoints(const Problem& P) const {
+        const Array& x0 = P.currentValue();
+        std::vector<Array> points(1, x0);
+        for (Size i=0; i<startingPoints_.size(); ++i) {
+            QL_REQUIRE(startingPoints_[i].size() == x0.size(),
+                       "starting point #" << i+1 << " has size "
+                       << startingPoints_[i].size() << ", "
+                       << x0.size() << " required");
+            points.push_back(startingPoints_[i]);
+        }
+        if (additionalStarts_ > 0) {
+            Array upper = P.constraint().upperBound(x0);
+            Array lower = P.constraint().lowerBound(x0);
+            for (Size j=0; j<x0.size(); ++j)
+                QL_REQUIRE(upper[j] < QL_MAX_REAL && lower[j] > -QL_MAX_REAL,
+                           "parameter #" << j+1 << " is not bounded; "
+                           "explicit starting points are required");
+            MersenneTwisterUniformRng rng(seed_);
+            for (Size i=0; i<additionalStarts_; ++i) {
+                Array x(x0.size());
+                for (Size j=0; j<x.size(); ++j)
+                    x[j] = lower[j] + (upper[j]-lower[j])*rng.nextReal();
+                points.push_back(x);
+            }
+        }
+        return points;
+    }
+
+    EndCriteria::Type MultiStartLevenbergMarquardt::minimize(
+                                            Problem& P,
+                                            const EndCriteria& endCriteria) {
+        P.reset();
+        const std::vector<Array> points = startingPoints(P);
+        const Size n = points.size();
+
+        std::vector<Array> minima(n);
+        std::vector<EndCriteria::Type> ecTypes(n, EndCriteria::None);
+        std::vector<std::string> failures(n);
+        std::vector<Integer> functionEvaluations(n, 0),
+                             gradientEvaluations(n, 0);
+        functionValues_ = std::vector<Real>(n, Null<Real>());
+
+        // each run has its own optimizer and problem, both of which
+        // hold per-run state; the cost function and the constraint
+        // are shared.  Exceptions can't cross the boundary of the
+        // parallel region and are stored instead.
+        const bool concurrent =
+            P.costFunction().allowsConcurrentEvaluation();
+        #pragma omp parallel for schedule(dynamic) if(concurrent)
+        for (long i=0; i<(long)n; ++i) {
+            try {
+                LevenbergMarquardt lm(epsfcn_, xtol_, gtol_,
+                                      useCostFunctionsJacobian_);
+                Problem problem(P.costFunction(), P.constraint(),
+                                points[i]);
+                try {
+                    ecTypes[i] = lm.minimize(problem, endCriteria);
+                } catch (...) {
+                    // the evaluations of failed runs are counted, too
+                    functionEvaluations[i] = problem.functionEvaluation();
+                    gradientEvaluations[i] = problem.gradientEvaluation();
+                    throw;
+                }
+                minima[i] = problem.currentValue();
+                functionValues_[i] = problem.functionValue();
+                functionEvaluations[i] = problem.functionEvaluation();
+                gradientEvaluations[i] = problem.gradientEvaluation();
+            } catch (std::exception& e) {
+                failures[i] = e.what();
+                if (failures[i].empty())
+                    failures[i] = "unknown error";
+            } catch (...) {
+                failures[i] = "unknown error";
+            }
+        }
+
+        // all runs count as evaluations of the original problem
+        for (Size i=0; i<n; ++i)
+            P.addEvaluations(functionEvaluations[i], gradientEvaluations[i]);
+
+        Size best = n;
+        for (Size i=0; i<n; ++i) {
+            if (failures[i].empty() &&
+                (best == n || functionValues_[i] < functionValues_[best]))
+                best = i;
+        }
+        if (best == n) {
+            for (Size i=0; i<n; ++i)
+                QL_REQUIRE(failures[i].empty(), failures[i]);
+        }
+
+        P.setCurrentValue(minima[best]);
+        P.setFunctionValue(functionValues_[best]);
+        return ecTypes[best];
+    }
+
+}
@@ -0,0 +1,95 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multistartlevenbergmarquardt.hpp
+    \brief Levenberg-Marquardt optimization from several starting points
+*/
+
+#ifndef quantlib_multistart_levenberg_marquardt_hpp
+#define quantlib_multistart_levenberg_marquardt_hpp
+
+#include <ql/math/optimization/problem.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Levenberg-Marquardt optimization from several starting points
+    /*! The local Levenberg-Marquardt optimizer is run from the current
+        value of the problem and from a number of additional starting
+        points, either given explicitly or drawn uniformly within the
+        bounds of the problem's constraint; the best of the local
+        minima is returned.
+
+        The runs are performed concurrently if OpenMP is enabled and
+        the cost function allows concurrent evaluation (see
+        CostFunction::allowsConcurrentEvaluation); otherwise, they are
+        performed one after the other.  In both cases the result
+        doesn't depend on the number of threads.
+
+        Runs failing with an error are discarded; if all runs fail,
+        the error of the first one is rethrown.
+
+        \ingroup optimizers
+    */
+    class MultiStartLevenbergMarquardt : public OptimizationMethod {
+      public:
+        //! runs the optimizer from the given additional starting points
+        MultiStartLevenbergMarquardt(
+                             const std::vector<Array>& startingPoints,
+                             Real epsfcn = 1.0e-8,
+                             Real xtol = 1.0e-8,
+                             Real gtol = 1.0e-8,
+                             bool useCostFunctionsJacobian = false);
+        /*! runs the optimizer from the given number of additional
+            starting points, drawn within the bounds of the constraint
+            of the problem; the latter must be finite.
+        */
+        MultiStartLevenbergMarquardt(
+                             Size additionalStarts,
+                             unsigned long seed =
+                                         SeedGenerator::instance().get(),
+                             Real epsfcn = 1.0e-8,
+                             Real xtol = 1.0e-8,
+                             Real gtol = 1.0e-8,
+                             bool useCostFunctionsJacobian = false);
+
+        virtual EndCriteria::Type minimize(Problem& P,
+                                           const EndCriteria& endCriteria);
+
+        //! final cost function values of the runs of the last minimization
+        /*! The first one is the run from the initial value of the
+            problem; failed runs are given a null value.
+        */
+        const std::vector<Real>& functionValues() const {
+            return functionValues_;
+        }
+
+      private:
+        Disposable<std::vector<Array> > startingPoints(
+                                                const Problem& P) const;
+        std::vector<Array> startingPoints_;
+        Size additionalStarts_;
+        unsigned long seed_;
+        Real epsfcn_, xtol_, gtol_;
+        bool useCostFunctionsJacobian_;
+        std::vector<Real> functionValues_;
+    };
+
+}
+
+#endif
@@ -80,11 +80,13 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.push_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
 
+        //Evaluate the swarm
+        pBF_ = P.batchValue(positions());
+
         //init topology & inertia
         topology_->init(this);
         inertia_->init(this);
@@ -148,8 +150,16 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
+            }
+
+            //Evaluate the swarm
+            Array F = P.batchValue(positions());
+
+            //Update personal bests
+            for (Size i = 0; i < M_; i++) {
+                const Array& x = X_[i];
+                Array& pB = pBX_[i];
+                Real f = F[i];
                 if (f < pBF_[i]) {
                     //Update personal best
                     pBF_[i] = f;
@@ -174,6 +184,13 @@ namespace QuantLib {
         return ecType;
     }
 
+    Disposable<Matrix> ParticleSwarmOptimization::positions() const {
+        Matrix result(M_, N_);
+        for (Size i = 0; i < M_; i++)
+            std::copy(X_[i].begin(), X_[i].end(), result.row_begin(i));
+        return result;
+    }
+
     void AdaptiveInertia::setValues() {
         Real currBest = (*pBF_)[0];
         for (Size i = 1; i < M_; i++) {
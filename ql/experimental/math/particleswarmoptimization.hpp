@@ -92,6 +92,10 @@ namespace QuantLib {
 
     The optimization stops either because the number of iterations has been reached
     or because the stationary function value limit has been reached.
+
+    The positions of the whole swarm are evaluated at each iteration with a single
+    call to CostFunction::batchValue, so that cost functions allowing it can
+    evaluate the particles concurrently.
     */
     class ParticleSwarmOptimization : public OptimizationMethod {
       public:
@@ -121,6 +125,8 @@ namespace QuantLib {
         MersenneTwisterUniformRng rng_;
         ext::shared_ptr<Topology> topology_;
         ext::shared_ptr<Inertia> inertia_;
+      private:
+        Disposable<Matrix> positions() const;
     };
 
     //! Base inertia class used to alter the PSO state
@@ -118,9 +118,75 @@ NoArbSabrModel::NoArbSabrModel(const Real expiryTime, const Real forward,
     numericalForward_ = d + externalForward_;
 }
 
+void NoArbSabrModel::enableDensityGrid(Size intervals) {
+    QL_REQUIRE(intervals > 0, "at least one grid interval required");
+
+    const Size n = intervals;
+    gridStep_ = (fmax_ - fmin_) / n;
+    gridDensity_.resize(n + 1);
+    for (Size i = 0; i <= n; ++i)
+        gridDensity_[i] = p(fmin_ + i * gridStep_);
+
+    // Simpson rule on each interval, accumulated from the right
+    gridMoment0_.assign(n + 1, 0.0);
+    gridMoment1_.assign(n + 1, 0.0);
+    for (Size i = n; i > 0; --i) {
+        const Real f0 = fmin_ + (i - 1) * gridStep_;
+        const Real f1 = fmin_ + i * gridStep_;
+        const Real fm = 0.5 * (f0 + f1);
+        const Real pm = p(fm);
+        gridMoment0_[i - 1] =
+            gridMoment0_[i] + gridStep_ / 6.0 *
+                                  (gridDensity_[i - 1] + 4.0 * pm + gridDensity_[i]);
+        gridMoment1_[i - 1] =
+            gridMoment1_[i] + gridStep_ / 6.0 *
+                                  (f0 * gridDensity_[i - 1] + 4.0 * fm * pm +
+                                   f1 * gridDensity_[i]);
+    }
+    QL_REQUIRE(gridMoment0_[0] > 0.0,
+               "density integrates to zero on the grid");
+}
+
+void NoArbSabrModel::disableDensityGrid() {
+    gridDensity_.clear();
+    gridMoment0_.clear();
+    gridMoment1_.clear();
+}
+
+void NoArbSabrModel::gridMoments(const Real strike, Real& moment0,
+                                 Real& moment1) const {
+    const Size n = gridDensity_.size() - 1;
+    if (strike <= fmin_) {
+        moment0 = gridMoment0_[0];
+        moment1 = gridMoment1_[0];
+    } else if (strike >= fmax_) {
+        moment0 = moment1 = 0.0;
+    } else {
+        const Size i = std::min(static_cast<Size>((strike - fmin_) / gridStep_),
+                                n - 1);
+        const Real f1 = fmin_ + (i + 1) * gridStep_;
+        const Real h = f1 - strike;
+        const Real fm = 0.5 * (strike + f1);
+        const Real pk = p(strike), pm = p(fm);
+        moment0 = gridMoment0_[i + 1] +
+                  h / 6.0 * (pk + 4.0 * pm + gridDensity_[i + 1]);
+        moment1 = gridMoment1_[i + 1] +
+                  h / 6.0 * (strike * pk + 4.0 * fm * pm +
+                             f1 * gridDensity_[i + 1]);
+    }
+    // normalize consistently with the grid
+    moment0 /= gridMoment0_[0];
+    moment1 /= gridMoment0_[0];
+}
+
 Real NoArbSabrModel::optionPrice(const Real strike) const {
     if (p(std::max(forward_, strike)) < detail::NoArbSabrModel::density_threshold)
         return 0.0;
+    if (hasDensityGrid()) {
+        Real moment0, moment1;
+        gridMoments(strike, moment0, moment1);
+        return (1.0 - absProb_) * (moment1 - strike * moment0);
+    }
     return (1.0 - absProb_) *
         ((*integrator_)(integrand(this, strike),
                         strike, std::max(fmax_, 2.0 * strike)) /
@@ -132,6 +198,11 @@ Real NoArbSabrModel::digitalOptionPrice(const Real strike) const {
         return 1.0;
     if (p(std::max(forward_, strike)) < detail::NoArbSabrModel::density_threshold)
         return 0.0;
+    if (hasDensityGrid()) {
+        Real moment0, moment1;
+        gridMoments(strike, moment0, moment1);
+        return (1.0 - absProb_) * moment0;
+    }
     return (1.0 - absProb_)
         * ((*integrator_)(p_integrand(this),
                           strike, std::max(fmax_, 2.0 * strike)) /
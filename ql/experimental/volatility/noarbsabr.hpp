@@ -45,6 +45,16 @@
     model implied forward different from the desired one.
     This situation can be identified by comparing forward()
     and numericalForward().
+
+    By default, option prices are calculated by adaptive
+    integration of the density for each strike.  Once a density
+    grid is enabled, the density is tabulated on a uniform grid
+    over the integration domain together with its cumulative
+    moments; the price for a given strike then only requires two
+    more evaluations of the density for the Simpson rule on the
+    grid interval containing the strike.  This pays off when many
+    strikes are priced for the same parameters, e.g., in CMS
+    replication.
 */
 
 #ifndef quantlib_noarb_sabr
@@ -121,6 +131,11 @@ class NoArbSabrModel {
 
     Real absorptionProbability() const { return absProb_; }
 
+    //! tabulates the density on the given number of intervals
+    void enableDensityGrid(Size intervals = 2000);
+    void disableDensityGrid();
+    bool hasDensityGrid() const { return !gridMoment0_.empty(); }
+
     private:
     Real p(const Real f) const;
     Real forwardError(const Real forward) const;
@@ -130,6 +145,10 @@ class NoArbSabrModel {
     mutable Real forward_, numericalIntegralOverP_;
     mutable Real numericalForward_;
     ext::shared_ptr<GaussLobattoIntegral> integrator_;
+    // density and its integrals times 1 and f from each node to fmax
+    Real gridStep_;
+    std::vector<Real> gridDensity_, gridMoment0_, gridMoment1_;
+    void gridMoments(Real strike, Real& moment0, Real& moment1) const;
     class integrand;
     friend class integrand;
     class p_integrand;
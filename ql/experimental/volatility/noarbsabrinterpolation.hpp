@@ -36,6 +36,9 @@ namespace detail {
 // we can directly use the smile section as the wrapper
 typedef NoArbSabrSmileSection NoArbSabrWrapper;
 
+// additional parameters are the shift (which must be zero) and the
+// number of density grid intervals (zero for no grid)
+
 struct NoArbSabrSpecs {
     Size dimension() { return 4; }
     Real eps() { return 0.000001; }
@@ -185,13 +188,22 @@ struct NoArbSabrSpecs {
     typedef NoArbSabrWrapper type;
     ext::shared_ptr<type> instance(const Time t, const Real &forward,
                                      const std::vector<Real> &params,
-                                     const std::vector<Real> &) {
-        return ext::make_shared<type>(t, forward, params);
+                                     const std::vector<Real> &addParams) {
+        Size densityGridIntervals =
+            addParams.size() > 1 ? static_cast<Size>(addParams[1]) : 0;
+        return ext::make_shared<type>(t, forward, params, 0.0,
+                                      densityGridIntervals);
     }
 };
 }
 
 //! no arbitrage sabr smile interpolation between discrete volatility points.
+/*! If densityGridIntervals is positive, the model density is
+    tabulated on that number of intervals (see
+    NoArbSabrModel::enableDensityGrid).  The grid is used during
+    the calibration as well, so that the fitted parameters are
+    consistent with the prices read from the grid.
+*/
 class NoArbSabrInterpolation : public Interpolation {
   public:
     template <class I1, class I2>
@@ -208,7 +220,8 @@ class NoArbSabrInterpolation : public Interpolation {
         const ext::shared_ptr<OptimizationMethod> &optMethod =
             ext::shared_ptr<OptimizationMethod>(),
         const Real errorAccept = 0.0020, const bool useMaxError = false,
-        const Size maxGuesses = 50, const Real shift = 0.0) {
+        const Size maxGuesses = 50, const Real shift = 0.0,
+        Size densityGridIntervals = 0) {
 
         QL_REQUIRE(shift==0.0,"NoArbSabrInterpolation for non zero shift not implemented");
         impl_ = ext::shared_ptr<Interpolation::Impl>(
@@ -218,7 +231,8 @@ class NoArbSabrInterpolation : public Interpolation {
                 boost::assign::list_of(alphaIsFixed)(betaIsFixed)(nuIsFixed)(
                     rhoIsFixed),
                 vegaWeighted, endCriteria, optMethod, errorAccept, useMaxError,
-                maxGuesses));
+                maxGuesses,
+                boost::assign::list_of(0.0)(Real(densityGridIntervals))));
         coeffs_ = ext::dynamic_pointer_cast<
             detail::XABRCoeffHolder<detail::NoArbSabrSpecs> >(impl_);
     }
@@ -250,20 +264,22 @@ class NoArbSabr {
               const ext::shared_ptr<OptimizationMethod> optMethod =
                   ext::shared_ptr<OptimizationMethod>(),
               const Real errorAccept = 0.0020, const bool useMaxError = false,
-              const Size maxGuesses = 50)
+              const Size maxGuesses = 50, Size densityGridIntervals = 0)
         : t_(t), forward_(forward), alpha_(alpha), beta_(beta), nu_(nu),
           rho_(rho), alphaIsFixed_(alphaIsFixed), betaIsFixed_(betaIsFixed),
           nuIsFixed_(nuIsFixed), rhoIsFixed_(rhoIsFixed),
           vegaWeighted_(vegaWeighted), endCriteria_(endCriteria),
           optMethod_(optMethod), errorAccept_(errorAccept),
-          useMaxError_(useMaxError), maxGuesses_(maxGuesses) {}
+          useMaxError_(useMaxError), maxGuesses_(maxGuesses),
+          densityGridIntervals_(densityGridIntervals) {}
     template <class I1, class I2>
     Interpolation interpolate(const I1 &xBegin, const I1 &xEnd,
                               const I2 &yBegin) const {
         return NoArbSabrInterpolation(
             xBegin, xEnd, yBegin, t_, forward_, alpha_, beta_, nu_, rho_,
             alphaIsFixed_, betaIsFixed_, nuIsFixed_, rhoIsFixed_, vegaWeighted_,
-            endCriteria_, optMethod_, errorAccept_, useMaxError_, maxGuesses_);
+            endCriteria_, optMethod_, errorAccept_, useMaxError_, maxGuesses_,
+            0.0, densityGridIntervals_);
     }
     static const bool global = true;
 
@@ -278,6 +294,7 @@ class NoArbSabr {
     const Real errorAccept_;
     const bool useMaxError_;
     const Size maxGuesses_;
+    const Size densityGridIntervals_;
 };
 }
 
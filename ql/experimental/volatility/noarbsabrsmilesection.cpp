@@ -26,16 +26,18 @@ namespace QuantLib {
 
 NoArbSabrSmileSection::NoArbSabrSmileSection(
     Time timeToExpiry, Rate forward, const std::vector<Real> &sabrParams,
-    Real shift)
+    Real shift, Size densityGridIntervals)
     : SmileSection(timeToExpiry, DayCounter()), forward_(forward),
-      params_(sabrParams), shift_(shift) {
+      params_(sabrParams), shift_(shift),
+      densityGridIntervals_(densityGridIntervals) {
     init();
 }
 
 NoArbSabrSmileSection::NoArbSabrSmileSection(
     const Date &d, Rate forward, const std::vector<Real> &sabrParams,
-    const DayCounter &dc, Real shift)
-    : SmileSection(d, dc, Date()), forward_(forward), params_(sabrParams), shift_(shift) {
+    const DayCounter &dc, Real shift, Size densityGridIntervals)
+    : SmileSection(d, dc, Date()), forward_(forward), params_(sabrParams),
+      shift_(shift), densityGridIntervals_(densityGridIntervals) {
     init();
 }
 
@@ -51,6 +53,8 @@ void NoArbSabrSmileSection::init() {
     model_ =
         ext::make_shared<NoArbSabrModel>(exerciseTime(), forward_, params_[0],
                                            params_[1], params_[2], params_[3]);
+    if (densityGridIntervals_ > 0)
+        model_->enableDensityGrid(densityGridIntervals_);
 }
 
 Real NoArbSabrSmileSection::optionPrice(Rate strike, Option::Type type,
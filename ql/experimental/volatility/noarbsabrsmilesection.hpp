@@ -31,16 +31,24 @@
 
 namespace QuantLib {
 
+/*! If densityGridIntervals is positive, the model density is
+    tabulated on that number of intervals (see
+    NoArbSabrModel::enableDensityGrid) and prices are read from
+    the grid; this is faster when many strikes are priced, e.g.,
+    in CMS replication.
+*/
 class NoArbSabrSmileSection : public SmileSection {
 
   public:
     NoArbSabrSmileSection(Time timeToExpiry, Rate forward,
                           const std::vector<Real> &sabrParameters,
-                          const Real shift = 0.0);
+                          const Real shift = 0.0,
+                          Size densityGridIntervals = 0);
     NoArbSabrSmileSection(const Date &d, Rate forward,
                           const std::vector<Real> &sabrParameters,
                           const DayCounter &dc = Actual365Fixed(),
-                          const Real shift = 0.0);
+                          const Real shift = 0.0,
+                          Size densityGridIntervals = 0);
     Real minStrike() const { return 0.0; }
     Real maxStrike() const { return QL_MAX_REAL; }
     Real atmLevel() const { return forward_; }
@@ -61,6 +69,7 @@ class NoArbSabrSmileSection : public SmileSection {
     Rate forward_;
     std::vector<Real> params_;
     Real shift_;
+    Size densityGridIntervals_;
 };
 }
 
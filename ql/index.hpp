@@ -92,19 +92,26 @@ namespace QuantLib {
                         bool forceOverwrite = false) {
             checkNativeFixingsAllowed();
             std::string tag = name();
-            TimeSeries<Real> h = IndexManager::instance().getHistory(tag);
+            const TimeSeries<Real>& h =
+                IndexManager::instance().getHistory(tag);
+            // fixings to be stored; checked as well for duplicates
+            // within the given ones
+            std::map<Date, Real> added;
             bool noInvalidFixing = true, noDuplicatedFixing = true;
             Date invalidDate, duplicatedDate;
             Real nullValue = Null<Real>();
             Real invalidValue = Null<Real>();
             Real duplicatedValue = Null<Real>();
+            Real previousValue = Null<Real>();
             while (dBegin != dEnd) {
                 bool validFixing = isValidFixingDate(*dBegin);
-                Real currentValue = h[*dBegin];
+                std::map<Date, Real>::const_iterator i = added.find(*dBegin);
+                Real currentValue = (i != added.end()) ? i->second
+                                                       : h[*dBegin];
                 bool missingFixing = forceOverwrite || currentValue == nullValue;
                 if (validFixing) {
                     if (missingFixing)
-                        h[*(dBegin++)] = *(vBegin++);
+                        added[*(dBegin++)] = *(vBegin++);
                     else if (close(currentValue,*(vBegin))) {
                         ++dBegin;
                         ++vBegin;
@@ -112,6 +119,7 @@ namespace QuantLib {
                         noDuplicatedFixing = false;
                         duplicatedDate = *(dBegin++);
                         duplicatedValue = *(vBegin++);
+                        previousValue = currentValue;
                     }
                 } else {
                     noInvalidFixing = false;
@@ -119,7 +127,18 @@ namespace QuantLib {
                     invalidValue = *(vBegin++);
                 }
             }
-            IndexManager::instance().setHistory(tag, h);
+            std::vector<Date> dates;
+            std::vector<Real> values;
+            dates.reserve(added.size());
+            values.reserve(added.size());
+            for (std::map<Date, Real>::const_iterator i = added.begin();
+                 i != added.end(); ++i) {
+                dates.push_back(i->first);
+                values.push_back(i->second);
+            }
+            IndexManager::instance().addFixings(tag,
+                                                dates.begin(), dates.end(),
+                                                values.begin());
             QL_REQUIRE(noInvalidFixing,
                        "At least one invalid fixing provided: " <<
                        invalidDate.weekday() << " " << invalidDate <<
@@ -127,7 +146,7 @@ namespace QuantLib {
             QL_REQUIRE(noDuplicatedFixing,
                        "At least one duplicated fixing provided: " <<
                        duplicatedDate << ", " << duplicatedValue <<
-                       " while " << h[duplicatedDate] <<
+                       " while " << previousValue <<
                        " value is already present");
         }
         //! clears all stored historical fixings
@@ -21,6 +21,10 @@
 
 #include <ql/indexes/iborindex.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -35,7 +39,8 @@ namespace QuantLib {
                          const Handle<YieldTermStructure>& h)
     : InterestRateIndex(familyName, tenor, settlementDays, currency,
                         fixingCalendar, dayCounter),
-      convention_(convention), termStructure_(h), endOfMonth_(endOfMonth) {
+      convention_(convention), termStructure_(h), endOfMonth_(endOfMonth),
+      perFixingNotifications_(false) {
         registerWith(termStructure_);
       }
 
@@ -60,7 +65,7 @@ namespace QuantLib {
 
     ext::shared_ptr<IborIndex> IborIndex::clone(
                                const Handle<YieldTermStructure>& h) const {
-        return ext::make_shared<IborIndex>(
+        ext::shared_ptr<IborIndex> index = ext::make_shared<IborIndex>(
                                         familyName(),
                                                       tenor(),
                                                       fixingDays(),
@@ -70,9 +75,36 @@ namespace QuantLib {
                                                       endOfMonth(),
                                                       dayCounter(),
                                                       h);
+        index->enablePerFixingNotifications(perFixingNotifications_);
+        return index;
     }
 
 
+    // compound factors shared by the indexes with the same name; as
+    // the fixing notifiers of the IndexManager, they are only stored
+    // as long as some index uses them
+    class OvernightIndex::CompoundFactorsRepository
+        : public Singleton<OvernightIndex::CompoundFactorsRepository> {
+        friend class Singleton<OvernightIndex::CompoundFactorsRepository>;
+      private:
+        CompoundFactorsRepository() {}
+      public:
+        ext::shared_ptr<CompoundFactors> get(const std::string& name) {
+            const std::string key = boost::algorithm::to_upper_copy(name);
+            ext::shared_ptr<CompoundFactors> factors = data_[key].lock();
+            if (!factors) {
+                factors = ext::make_shared<CompoundFactors>();
+                factors->registerWith(
+                                   IndexManager::instance().notifier(name));
+                data_[key] = factors;
+            }
+            return factors;
+        }
+      private:
+        std::map<std::string, ext::weak_ptr<CompoundFactors> > data_;
+    };
+
+
     OvernightIndex::OvernightIndex(const std::string& familyName,
                                    Natural settlementDays,
                                    const Currency& curr,
@@ -80,17 +112,79 @@ namespace QuantLib {
                                    const DayCounter& dc,
                                    const Handle<YieldTermStructure>& h)
    : IborIndex(familyName, 1*Days, settlementDays, curr,
-               fixCal, Following, false, dc, h) {}
+               fixCal, Following, false, dc, h),
+     compoundFactors_(CompoundFactorsRepository::instance().get(name())) {}
 
     ext::shared_ptr<IborIndex> OvernightIndex::clone(
                                const Handle<YieldTermStructure>& h) const {
-        return ext::shared_ptr<IborIndex>(
+        ext::shared_ptr<IborIndex> index(
                                         new OvernightIndex(familyName(),
                                                            fixingDays(),
                                                            currency(),
                                                            fixingCalendar(),
                                                            dayCounter(),
                                                            h));
+        index->enablePerFixingNotifications(perFixingNotifications_);
+        return index;
+    }
+
+    Real OvernightIndex::compoundFactor(const Date& first,
+                                        const Date& last,
+                                        Size n) const {
+        if (n == 0)
+            return 1.0;
+        if (!compoundFactors_->valid)
+            buildCompoundFactors();
+
+        const std::vector<Date>& dates = compoundFactors_->dates;
+        std::vector<Date>::const_iterator i =
+            std::lower_bound(dates.begin(), dates.end(), first);
+        if (i == dates.end() || *i != first)
+            return Null<Real>();
+        const Size begin = i - dates.begin(), end = begin + n;
+        if (end > dates.size() || dates[end-1] != last)
+            return Null<Real>();
+
+        const std::vector<Size>& missing = compoundFactors_->missing;
+        if (missing[end] != missing[begin])
+            return Null<Real>();
+
+        const std::vector<Real>& factors = compoundFactors_->factors;
+        return factors[end] / factors[begin];
+    }
+
+    void OvernightIndex::buildCompoundFactors() const {
+        std::vector<Date>& dates = compoundFactors_->dates;
+        std::vector<Real>& factors = compoundFactors_->factors;
+        std::vector<Size>& missing = compoundFactors_->missing;
+        dates.clear();
+        factors.assign(1, 1.0);
+        missing.assign(1, 0);
+
+        const TimeSeries<Real>& history = timeSeries();
+        if (!history.empty()) {
+            const Calendar& calendar = fixingCalendar();
+            const Date last = history.lastDate();
+            Date d = calendar.adjust(history.firstDate());
+            Date start = valueDate(d);
+            while (d <= last) {
+                Date next = calendar.advance(d, 1, Days);
+                Date end = valueDate(next);
+                Rate f = history[d];
+                dates.push_back(d);
+                if (f != Null<Real>()) {
+                    factors.push_back(factors.back() *
+                        (1.0 + f*dayCounter_.yearFraction(start, end)));
+                    missing.push_back(missing.back());
+                } else {
+                    factors.push_back(factors.back());
+                    missing.push_back(missing.back() + 1);
+                }
+                d = next;
+                start = end;
+            }
+        }
+        compoundFactors_->valid = true;
     }
 
 }
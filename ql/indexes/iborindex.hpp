@@ -62,10 +62,27 @@ namespace QuantLib {
         virtual ext::shared_ptr<IborIndex> clone(
                         const Handle<YieldTermStructure>& forwarding) const;
         // @}
+        //! \name Coupon notifications
+        //@{
+        /*! When enabled, coupons on this index observe the fixings
+            they use and the forwarding term structure instead of the
+            index as a whole, so that they're not notified when other
+            fixings are added.  It is disabled by default; enable it
+            only if the index has no dependencies other than its
+            fixings and its forwarding term structure (which is not
+            the case, e.g., for ProxyIbor).  It is ignored when no
+            forwarding term structure is set, and it only affects
+            coupons built after it was changed.
+        */
+        void enablePerFixingNotifications(bool b = true);
+        void disablePerFixingNotifications();
+        bool allowsPerFixingNotifications() const;
+        //@}
       protected:
         BusinessDayConvention convention_;
         Handle<YieldTermStructure> termStructure_;
         bool endOfMonth_;
+        bool perFixingNotifications_;
       private:
         // overload to avoid date/time (re)calculation
         /* This can be called with cached coupon dates (and it does
@@ -98,6 +115,40 @@ namespace QuantLib {
         //! returns a copy of itself linked to a different forwarding curve
         ext::shared_ptr<IborIndex> clone(
                                    const Handle<YieldTermStructure>& h) const;
+        //! compounded past fixings
+        /*! Returns the product of the factors
+            \f$ (1 + f_i \tau_i) \f$ for the \f$ n \f$ consecutive
+            fixing dates from \c first to \c last (included), where
+            \f$ \tau_i \f$ is the accrual period between the value
+            dates of consecutive fixings.  The result is obtained as
+            the ratio of two elements of a cumulative product over
+            all stored fixings, which is cached and rebuilt when the
+            fixings change.  As the fixings, the cache is shared by
+            all the indexes with the same name.
+
+            Null<Real>() is returned when the result can't be obtained
+            from the stored fixings, i.e., when any fixing is missing
+            or when the given dates are not \f$ n \f$ consecutive
+            fixing dates.
+        */
+        Real compoundFactor(const Date& first, const Date& last,
+                            Size n) const;
+      private:
+        class CompoundFactors : public Observer {
+          public:
+            CompoundFactors() : valid(false) {}
+            void update() { valid = false; }
+            bool valid;
+            // fixing dates between the first and last stored fixing
+            std::vector<Date> dates;
+            // cumulative products and counts of missing fixings
+            // before each date; one element longer than dates
+            std::vector<Real> factors;
+            std::vector<Size> missing;
+        };
+        class CompoundFactorsRepository;
+        void buildCompoundFactors() const;
+        ext::shared_ptr<CompoundFactors> compoundFactors_;
     };
 
 
@@ -112,6 +163,18 @@ namespace QuantLib {
         return termStructure_;
     }
 
+    inline void IborIndex::enablePerFixingNotifications(bool b) {
+        perFixingNotifications_ = b;
+    }
+
+    inline void IborIndex::disablePerFixingNotifications() {
+        perFixingNotifications_ = false;
+    }
+
+    inline bool IborIndex::allowsPerFixingNotifications() const {
+        return perFixingNotifications_;
+    }
+
     inline Rate IborIndex::forecastFixing(const Date& d1,
                                           const Date& d2,
                                           Time t) const {
@@ -18,6 +18,7 @@
 */
 
 #include <ql/indexes/indexmanager.hpp>
+#include <algorithm>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -32,40 +33,119 @@ using std::string;
 
 namespace QuantLib {
 
+    IndexManager::History&
+    IndexManager::history(const string& name) const {
+        History& h = data_[to_upper_copy(name)];
+        h.cleared = false;
+        return h;
+    }
+
     bool IndexManager::hasHistory(const string& name) const {
-        return data_.find(to_upper_copy(name)) != data_.end();
+        history_map::const_iterator i = data_.find(to_upper_copy(name));
+        return i != data_.end() && !i->second.cleared;
     }
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        return history(name).fixings;
     }
 
     void IndexManager::setHistory(const string& name,
-                                  const TimeSeries<Real>& history) {
-        data_[to_upper_copy(name)] = history;
+                                  const TimeSeries<Real>& fixings) {
+        History& h = history(name);
+        h.fixings = fixings;
+        notifyChanges(h, 0);
+    }
+
+    void IndexManager::notifyChanges(
+               History& h,
+               std::vector<ext::shared_ptr<Observable> >* changed) const {
+        // collect the live notifiers first, since observers might
+        // request further notifiers while being notified
+        std::vector<ext::shared_ptr<Observable> > all;
+        if (!changed)
+            all.reserve(h.fixingNotifiers.size());
+        notifier_map::iterator i = h.fixingNotifiers.begin();
+        while (i != h.fixingNotifiers.end()) {
+            if (i->second.expired()) {
+                h.fixingNotifiers.erase(i++);
+            } else {
+                if (!changed)
+                    all.push_back(i->second.lock());
+                ++i;
+            }
+        }
+        if (changed) {
+            std::sort(changed->begin(), changed->end());
+            changed->erase(std::unique(changed->begin(), changed->end()),
+                           changed->end());
+        } else {
+            changed = &all;
+        }
+        fixingNotifications_ += changed->size();
+        avoidedFixingNotifications_ +=
+            h.fixingNotifiers.size() - changed->size();
+
+        h.notifier->notifyObservers();
+        for (Size i=0; i<changed->size(); ++i)
+            (*changed)[i]->notifyObservers();
     }
 
     ext::shared_ptr<Observable>
     IndexManager::notifier(const string& name) const {
-        return data_[to_upper_copy(name)];
+        return history(name).notifier;
+    }
+
+    ext::shared_ptr<Observable>
+    IndexManager::notifier(const string& name, const Date& fixingDate) const {
+        ext::weak_ptr<Observable>& stored =
+            history(name).fixingNotifiers[fixingDate];
+        ext::shared_ptr<Observable> n = stored.lock();
+        if (!n) {
+            n = ext::make_shared<Observable>();
+            stored = n;
+        }
+        return n;
     }
 
     std::vector<string> IndexManager::histories() const {
         std::vector<string> temp;
         temp.reserve(data_.size());
         for (history_map::const_iterator i=data_.begin();
-             i!=data_.end(); ++i)
-            temp.push_back(i->first);
+             i!=data_.end(); ++i) {
+            if (!i->second.cleared)
+                temp.push_back(i->first);
+        }
+        std::sort(temp.begin(), temp.end());
         return temp;
     }
 
     void IndexManager::clearHistory(const string& name) {
-        data_.erase(to_upper_copy(name));
+        history_map::iterator i = data_.find(to_upper_copy(name));
+        if (i != data_.end() && !i->second.cleared) {
+            i->second.fixings = TimeSeries<Real>();
+            i->second.cleared = true;
+            notifyChanges(i->second, 0);
+        }
     }
 
     void IndexManager::clearHistories() {
-        data_.clear();
+        // observers might access other histories while being notified,
+        // which would invalidate the iterators; references stay valid.
+        std::vector<History*> cleared;
+        for (history_map::iterator i=data_.begin(); i!=data_.end(); ++i) {
+            if (!i->second.cleared) {
+                i->second.fixings = TimeSeries<Real>();
+                i->second.cleared = true;
+                cleared.push_back(&(i->second));
+            }
+        }
+        for (Size i=0; i<cleared.size(); ++i)
+            notifyChanges(*cleared[i], 0);
+    }
+
+    void IndexManager::resetFixingNotificationCounters() {
+        fixingNotifications_ = avoidedFixingNotifications_ = 0;
     }
 
 }
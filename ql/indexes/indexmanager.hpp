@@ -27,16 +27,31 @@
 #include <ql/timeseries.hpp>
 #include <ql/patterns/singleton.hpp>
 #include <ql/utilities/observablevalue.hpp>
+#include <map>
+
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#endif
+#include <boost/unordered_map.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic pop
+#endif
 
 
 namespace QuantLib {
 
     //! global repository for past index fixings
-    /*! \note index names are case insensitive */
+    /*! Histories are stored in a hash table keyed by the upper-case
+        index name.
+
+        \note index names are case insensitive
+    */
     class IndexManager : public Singleton<IndexManager> {
         friend class Singleton<IndexManager>;
       private:
-        IndexManager() {}
+        IndexManager()
+        : fixingNotifications_(0), avoidedFixingNotifications_(0) {}
       public:
         //! returns whether historical fixings were stored for the index
         bool hasHistory(const std::string& name) const;
@@ -44,20 +59,93 @@ namespace QuantLib {
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
+        //! adds fixings to the history of the index
+        /*! Fixings already stored at the same dates are overwritten.
+            The stored history is modified in place, and observers
+            are notified once after all fixings have been added.
+        */
+        template <class DateIterator, class ValueIterator>
+        void addFixings(const std::string& name,
+                        DateIterator dBegin, DateIterator dEnd,
+                        ValueIterator vBegin);
         //! observer notifying of changes in the index fixings
         ext::shared_ptr<Observable> notifier(const std::string& name) const;
+        //! observer notifying of changes in the index fixing at a given date
+        /*! Observers depending only on a few fixings of an index
+            (e.g., coupons) can register with these notifiers instead
+            of the index, so that they're not notified when other
+            fixings are added.  Notifiers are only stored as long as
+            some observer is registered with them.
+        */
+        ext::shared_ptr<Observable> notifier(const std::string& name,
+                                             const Date& fixingDate) const;
         //! returns all names of the indexes for which fixings were stored
         std::vector<std::string> histories() const;
-        //! clears the historical fixings of the index
+        //! clears the historical fixings of the index and notifies observers
         void clearHistory(const std::string& name);
-        //! clears all stored fixings
+        //! clears all stored fixings and notifies observers
         void clearHistories();
+
+        //! \name Fixing notifications
+        //@{
+        //! number of single-fixing notifiers notified of a change
+        Size fixingNotifications() const { return fixingNotifications_; }
+        /*! number of single-fixing notifiers which were not notified
+            since their fixing was not among the changed ones
+        */
+        Size avoidedFixingNotifications() const {
+            return avoidedFixingNotifications_;
+        }
+        void resetFixingNotificationCounters();
+        //@}
       private:
-        typedef std::map<std::string, ObservableValue<TimeSeries<Real> > >
-                                                                  history_map;
+        // the observers registered with a notifier keep it alive
+        typedef std::map<Date, ext::weak_ptr<Observable> > notifier_map;
+        struct History {
+            History() : notifier(new Observable), cleared(false) {}
+            TimeSeries<Real> fixings;
+            ext::shared_ptr<Observable> notifier;
+            notifier_map fixingNotifiers;
+            // cleared histories are kept so that their observers
+            // are still notified when new fixings are stored
+            bool cleared;
+        };
+        History& history(const std::string& name) const;
+        // notifies the observers of the whole history and of the
+        // given fixings (or of all fixings, if null); also removes
+        // the notifiers that were destroyed
+        void notifyChanges(
+               History& h,
+               std::vector<ext::shared_ptr<Observable> >* changed) const;
+        typedef boost::unordered_map<std::string, History> history_map;
         mutable history_map data_;
+        mutable Size fixingNotifications_, avoidedFixingNotifications_;
     };
 
+
+    // template definitions
+
+    template <class DateIterator, class ValueIterator>
+    void IndexManager::addFixings(const std::string& name,
+                                  DateIterator dBegin, DateIterator dEnd,
+                                  ValueIterator vBegin) {
+        History& h = history(name);
+        std::vector<ext::shared_ptr<Observable> > changed;
+        for (; dBegin != dEnd; ++dBegin, ++vBegin) {
+            const Date d = *dBegin;
+            h.fixings[d] = *vBegin;
+            if (!h.fixingNotifiers.empty()) {
+                notifier_map::const_iterator i = h.fixingNotifiers.find(d);
+                if (i != h.fixingNotifiers.end()) {
+                    ext::shared_ptr<Observable> n = i->second.lock();
+                    if (n)
+                        changed.push_back(n);
+                }
+            }
+        }
+        notifyChanges(h, &changed);
+    }
+
 }
 
 
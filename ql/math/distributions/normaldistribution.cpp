@@ -22,6 +22,7 @@
 
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
+#include <algorithm>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -126,6 +127,57 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::standard_values(const Real* begin,
+                                                  const Real* end,
+                                                  Real* out) {
+        // The input is processed in chunks so that the results can be
+        // buffered until the tails are fixed; this allows the output
+        // range to coincide with the input one.
+        const Size chunk = 64;
+        Real z[chunk];
+        while (begin != end) {
+            const Size n = std::min<Size>(end - begin, chunk);
+
+            // central region, evaluated for every value; the
+            // denominator doesn't vanish for any 0 < x < 1.
+            for (Size i=0; i<n; ++i) {
+                const Real y = begin[i] - 0.5;
+                const Real r = y*y;
+                z[i] = (((((a1_*r+a2_)*r+a3_)*r+a4_)*r+a5_)*r+a6_)*y /
+                    (((((b1_*r+b2_)*r+b3_)*r+b4_)*r+b5_)*r+1.0);
+            }
+
+            // tails
+            for (Size i=0; i<n; ++i) {
+                if (begin[i] < x_low_ || x_high_ < begin[i])
+                    z[i] = tail_value(begin[i]);
+            }
+
+            #ifdef REFINE_TO_FULL_MACHINE_PRECISION_USING_HALLEYS_METHOD
+            for (Size i=0; i<n; ++i) {
+                const Real r = (f_(z[i]) - begin[i])
+                    * M_SQRT2 * M_SQRTPI * exp(0.5 * z[i]*z[i]);
+                z[i] -= r/(1+0.5*z[i]*r);
+            }
+            #endif
+
+            std::copy(z, z+n, out);
+            begin += n;
+            out += n;
+        }
+    }
+
+    void InverseCumulativeNormal::operator()(const Real* begin,
+                                             const Real* end,
+                                             Real* out) const {
+        standard_values(begin, end, out);
+        if (average_ != 0.0 || sigma_ != 1.0) {
+            const Size n = end - begin;
+            for (Size i=0; i<n; ++i)
+                out[i] = average_ + sigma_*out[i];
+        }
+    }
+
     const Real MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const Real MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const Real MoroInverseCumulativeNormal::a2_ = 41.39119773534;
@@ -143,6 +143,21 @@ namespace QuantLib {
 
             return z;
         }
+        //! transforms a whole sequence at once
+        /*! Equivalent to applying operator() to each element of the
+            range [begin, end) and storing the results starting at
+            out; the output range can coincide with the input one.
+
+            The central region is evaluated for all elements in a
+            first, branch-free pass which the compiler can vectorize;
+            the few elements falling in the tails are corrected in a
+            second pass.
+        */
+        void operator()(const Real* begin, const Real* end,
+                        Real* out) const;
+        //! same as above for average=0, sigma=1
+        static void standard_values(const Real* begin, const Real* end,
+                                    Real* out);
       private:
         /* Handling tails moved into a separate method, which should
            make the inlining of operator() and standard_value method
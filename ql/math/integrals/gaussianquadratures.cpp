@@ -26,34 +26,117 @@
 #include <ql/math/matrixutilities/tqreigendecomposition.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
 
+#include <boost/detail/lightweight_mutex.hpp>
+#include <map>
+
 namespace QuantLib {
 
+    namespace {
+
+        struct RuleKey {
+            int family;
+            Size order;
+            Real parameter1, parameter2;
+            bool operator<(const RuleKey& k) const {
+                if (family != k.family)
+                    return family < k.family;
+                if (order != k.order)
+                    return order < k.order;
+                if (parameter1 != k.parameter1)
+                    return parameter1 < k.parameter1;
+                return parameter2 < k.parameter2;
+            }
+        };
+
+        // nodes and weights
+        typedef std::pair<Array, Array> Rule;
+
+        // process-wide; since parameters are continuous, the table is
+        // cleared when full, so rules are only read under the lock
+        const Size maxRules = 256;
+
+        std::map<RuleKey, Rule>& rules() {
+            static std::map<RuleKey, Rule> rules_;
+            return rules_;
+        }
+
+        boost::detail::lightweight_mutex& rulesMutex() {
+            static boost::detail::lightweight_mutex mutex_;
+            return mutex_;
+        }
+
+    }
+
     GaussianQuadrature::GaussianQuadrature(
                                 Size n,
                                 const GaussianOrthogonalPolynomial& orthPoly)
     : x_(n), w_(n) {
+        calculate(n, orthPoly, x_, w_);
+    }
+
+    GaussianQuadrature::GaussianQuadrature(
+                                Size n,
+                                const GaussianOrthogonalPolynomial& orthPoly,
+                                Family family,
+                                Real parameter1,
+                                Real parameter2) {
+        const RuleKey key = { family, n, parameter1, parameter2 };
+
+        // the lock is not held while the rule is calculated; if
+        // another thread stores the same rule meanwhile, that one is
+        // used and ours is discarded
+        {
+            boost::detail::lightweight_mutex::scoped_lock
+                guard(rulesMutex());
+            std::map<RuleKey, Rule>::const_iterator i = rules().find(key);
+            if (i != rules().end()) {
+                x_ = i->second.first;
+                w_ = i->second.second;
+                return;
+            }
+        }
+
+        Rule calculated = Rule(Array(n), Array(n));
+        calculate(n, orthPoly, calculated.first, calculated.second);
+
+        boost::detail::lightweight_mutex::scoped_lock guard(rulesMutex());
+        std::map<RuleKey, Rule>::const_iterator i = rules().find(key);
+        if (i == rules().end()) {
+            if (rules().size() >= maxRules)
+                rules().clear();
+            i = rules().insert(std::make_pair(key, calculated)).first;
+        }
+        x_ = i->second.first;
+        w_ = i->second.second;
+    }
+
+    void GaussianQuadrature::calculate(
+                                Size n,
+                                const GaussianOrthogonalPolynomial& orthPoly,
+                                Array& x,
+                                Array& w) const {
 
         // set-up matrix to compute the roots and the weights
         Array e(n-1);
 
         Size i;
         for (i=1; i < n; ++i) {
-            x_[i] = orthPoly.alpha(i);
+            x[i] = orthPoly.alpha(i);
             e[i-1] = std::sqrt(orthPoly.beta(i));
         }
-        x_[0] = orthPoly.alpha(0);
+        x[0] = orthPoly.alpha(0);
 
         TqrEigenDecomposition tqr(
-                               x_, e,
+                               x, e,
                                TqrEigenDecomposition::OnlyFirstRowEigenVector,
                                TqrEigenDecomposition::Overrelaxation);
 
-        x_ = tqr.eigenvalues();
+        x = tqr.eigenvalues();
         const Matrix& ev = tqr.eigenvectors();
 
         Real mu_0 = orthPoly.mu_0();
         for (i=0; i<n; ++i) {
-            w_[i] = mu_0*ev[0][i]*ev[0][i] / orthPoly.w(x_[i]);
+            w[i] = mu_0*ev[0][i]*ev[0][i] / orthPoly.w(x[i]);
         }
     }
 
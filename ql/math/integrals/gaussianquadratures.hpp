@@ -41,6 +41,15 @@ namespace QuantLib {
         "Numerical Recipes in C", 2nd edition,
         Press, Teukolsky, Vetterling, Flannery,
 
+        The nodes and weights of the rules of the named families
+        below (Gauss-Laguerre, Gauss-Hermite, Gauss-Jacobi and its
+        special cases, Gauss-Hyperbolic) are stored once calculated,
+        and copied by all the quadratures using the same order and
+        parameters; quadratures can be built concurrently.  Since
+        the parameters can take any value, at most 256 rules are
+        stored and the table is cleared when full.  Quadratures
+        built on a generic polynomial calculate their own.
+
         \test the correctness of the result is tested by checking it
               against known good values.
     */
@@ -68,11 +77,22 @@ namespace QuantLib {
 #endif
 
         Size order() const { return x_.size(); }
-        const Array& weights() { return w_; }
-        const Array& x()       { return x_; }
+        const Array& weights() const { return w_; }
+        const Array& x()       const { return x_; }
         
       protected:
+        enum Family { Laguerre, Hermite, Jacobi, Hyperbolic };
+        //! uses the shared rule for the given family and parameters
+        GaussianQuadrature(Size n,
+                           const GaussianOrthogonalPolynomial& p,
+                           Family family,
+                           Real parameter1 = 0.0,
+                           Real parameter2 = 0.0);
+
         Array x_, w_;
+      private:
+        void calculate(Size n, const GaussianOrthogonalPolynomial& p,
+                       Array& x, Array& w) const;
     };
 
 
@@ -90,7 +110,7 @@ namespace QuantLib {
     class GaussLaguerreIntegration : public GaussianQuadrature {
       public:
         explicit GaussLaguerreIntegration(Size n, Real s = 0.0)
-        : GaussianQuadrature(n, GaussLaguerrePolynomial(s)) {}
+        : GaussianQuadrature(n, GaussLaguerrePolynomial(s), Laguerre, s) {}
     };
 
     //! generalized Gauss-Hermite integration
@@ -107,7 +127,7 @@ namespace QuantLib {
     class GaussHermiteIntegration : public GaussianQuadrature {
       public:
         explicit GaussHermiteIntegration(Size n, Real mu = 0.0)
-        : GaussianQuadrature(n, GaussHermitePolynomial(mu)) {}
+        : GaussianQuadrature(n, GaussHermitePolynomial(mu), Hermite, mu) {}
     };
 
     //! Gauss-Jacobi integration
@@ -123,7 +143,8 @@ namespace QuantLib {
     class GaussJacobiIntegration : public GaussianQuadrature {
       public:
         GaussJacobiIntegration(Size n, Real alpha, Real beta)
-        : GaussianQuadrature(n, GaussJacobiPolynomial(alpha, beta)) {}
+        : GaussianQuadrature(n, GaussJacobiPolynomial(alpha, beta),
+                             Jacobi, alpha, beta) {}
     };
 
     //! Gauss-Hyperbolic integration
@@ -139,7 +160,7 @@ namespace QuantLib {
     class GaussHyperbolicIntegration : public GaussianQuadrature {
       public:
         explicit GaussHyperbolicIntegration(Size n)
-        : GaussianQuadrature(n, GaussHyperbolicPolynomial()) {}
+        : GaussianQuadrature(n, GaussHyperbolicPolynomial(), Hyperbolic) {}
     };
 
     //! Gauss-Legendre integration
@@ -155,7 +176,8 @@ namespace QuantLib {
     class GaussLegendreIntegration : public GaussianQuadrature {
       public:
         explicit GaussLegendreIntegration(Size n)
-        : GaussianQuadrature(n, GaussJacobiPolynomial(0.0, 0.0)) {}
+        : GaussianQuadrature(n, GaussJacobiPolynomial(0.0, 0.0),
+                             Jacobi, 0.0, 0.0) {}
     };
 
     //! Gauss-Chebyshev integration
@@ -171,7 +193,8 @@ namespace QuantLib {
     class GaussChebyshevIntegration : public GaussianQuadrature {
       public:
         explicit GaussChebyshevIntegration(Size n)
-        : GaussianQuadrature(n, GaussJacobiPolynomial(-0.5, -0.5)) {}
+        : GaussianQuadrature(n, GaussJacobiPolynomial(-0.5, -0.5),
+                             Jacobi, -0.5, -0.5) {}
     };
 
     //! Gauss-Chebyshev integration (second kind)
@@ -187,7 +210,8 @@ namespace QuantLib {
     class GaussChebyshev2ndIntegration : public GaussianQuadrature {
       public:
         explicit GaussChebyshev2ndIntegration(Size n)
-      : GaussianQuadrature(n, GaussJacobiPolynomial(0.5, 0.5)) {}
+      : GaussianQuadrature(n, GaussJacobiPolynomial(0.5, 0.5),
+                           Jacobi, 0.5, 0.5) {}
     };
 
     //! Gauss-Gegenbauer integration
@@ -203,7 +227,8 @@ namespace QuantLib {
     class GaussGegenbauerIntegration : public GaussianQuadrature {
       public:
         GaussGegenbauerIntegration(Size n, Real lambda)
-        : GaussianQuadrature(n, GaussJacobiPolynomial(lambda-0.5, lambda-0.5))
+        : GaussianQuadrature(n, GaussJacobiPolynomial(lambda-0.5, lambda-0.5),
+                             Jacobi, lambda-0.5, lambda-0.5)
         {}
     };
 
@@ -32,6 +32,7 @@
 
 #include <ql/math/interpolations/xabrinterpolation.hpp>
 #include <ql/termstructures/volatility/sabr.hpp>
+#include <ql/utilities/dataformatters.hpp>
 
 #include <boost/assign/list_of.hpp>
 
@@ -44,22 +45,28 @@ class SABRWrapper {
     SABRWrapper(const Time t, const Real &forward,
                 const std::vector<Real> &params,
                 const std::vector<Real> &addParams)
-        : t_(t), forward_(forward), params_(params),
-          shift_(addParams.size() == 0 ? 0.0 : addParams[0]) {
-        QL_REQUIRE(forward_ + shift_ > 0.0, "forward+shift must be positive: "
-                                                 << forward_ << " with shift "
+        : shift_(addParams.size() == 0 ? 0.0 : addParams[0]),
+          kernel_(forward, t, params[0], params[1], params[2], params[3],
+                  shift_) {
+        QL_REQUIRE(forward + shift_ > 0.0, "forward+shift must be positive: "
+                                                 << forward << " with shift "
                                                  << shift_ << " not allowed");
+        QL_REQUIRE(t >= 0.0, "expiry time must be non-negative: "
+                                 << t << " not allowed");
         validateSabrParameters(params[0], params[1], params[2], params[3]);
     }
     Real volatility(const Real x) {
-        return shiftedSabrVolatility(x, forward_, t_, params_[0], params_[1],
-                                     params_[2], params_[3], shift_);
+        QL_REQUIRE(x + shift_ > 0.0, "strike+shift must be positive: "
+                   << io::rate(x) << "+" << io::rate(shift_)
+                   << " not allowed");
+        return kernel_(x);
     }
 
   private:
-    const Real t_, &forward_;
-    const std::vector<Real> &params_;
     const Real shift_;
+    // the strike-independent terms are calculated once per instance;
+    // a new instance is created whenever the parameters change
+    const SabrVolatilityKernel kernel_;
 };
 
 struct SABRSpecs {
@@ -225,6 +225,7 @@ class XABRInterpolationImpl : public Interpolation::templateImpl<I1, I2>,
 
             for (Size i = 0; i < bestParameters.size(); ++i)
                 this->params_[i] = bestParameters[i];
+            this->updateModelInstance();
 
             this->error_ = interpolationError();
             this->maxError_ = interpolationMaxError();
@@ -28,6 +28,8 @@
 #include <ql/math/array.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/math/functional.hpp>
+#include <string>
+#include <vector>
 
 namespace QuantLib {
 
@@ -45,6 +47,52 @@ namespace QuantLib {
         //! method to overload to compute the cost function values in x
         virtual Disposable<Array> values(const Array& x) const =0;
 
+        //! method to overload to compute the cost function value at
+        //  each row of the population matrix
+        /*! This is used by the population-based global optimizers to
+            evaluate a whole generation of candidates at once.  The
+            default implementation calls value() for each row; the
+            rows are evaluated concurrently if OpenMP is enabled and
+            allowsConcurrentEvaluation() returns true.  If any
+            evaluation fails, the error of the first failing row is
+            rethrown.
+        */
+        virtual Disposable<Array> batchValue(const Matrix& population) const {
+            Array result(population.rows());
+            #ifdef _OPENMP
+            if (allowsConcurrentEvaluation() && population.rows() > 1) {
+                // exceptions can't cross the boundary of the parallel
+                // region; the one from the first failing row is rethrown
+                std::vector<std::string> failures(population.rows());
+                #pragma omp parallel for schedule(dynamic)
+                for (long i=0; i<(long)population.rows(); ++i) {
+                    try {
+                        result[i] = value(Array(population.row_begin(i),
+                                                population.row_end(i)));
+                    } catch (std::exception& e) {
+                        failures[i] = e.what();
+                        if (failures[i].empty())
+                            failures[i] = "unknown error";
+                    } catch (...) {
+                        failures[i] = "unknown error";
+                    }
+                }
+                for (Size i=0; i<failures.size(); ++i)
+                    QL_REQUIRE(failures[i].empty(), failures[i]);
+                return result;
+            }
+            #endif
+            for (Size i=0; i<population.rows(); ++i)
+                result[i] = value(Array(population.row_begin(i),
+                                        population.row_end(i)));
+            return result;
+        }
+
+        //! whether value() can be called concurrently from different
+        //  threads; cost functions that modify shared state (e.g., the
+        //  parameters of a model being calibrated) must return false
+        virtual bool allowsConcurrentEvaluation() const { return false; }
+
         //! method to overload to compute grad_f, the first derivative of
         //  the cost function with respect to x
         virtual void gradient(Array& grad, const Array& x) const {
@@ -269,11 +269,34 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
-            try {
-                population[popIter].cost = costFunction.value(population[popIter].values);
-            } catch (Error&) {
-                population[popIter].cost = QL_MAX_REAL;
+        }
+        evaluate(population, costFunction);
+    }
+
+    void DifferentialEvolution::evaluate(
+                                     std::vector<Candidate>& population,
+                                     const CostFunction& costFunction) const {
+        Matrix candidates(population.size(),
+                          population.front().values.size());
+        for (Size popIter = 0; popIter < population.size(); popIter++) {
+            std::copy(population[popIter].values.begin(),
+                      population[popIter].values.end(),
+                      candidates.row_begin(popIter));
+        }
+        try {
+            Array costs = costFunction.batchValue(candidates);
+            for (Size popIter = 0; popIter < population.size(); popIter++)
+                population[popIter].cost = costs[popIter];
+        } catch (Error&) {
+            // evaluate the candidates one by one so that only the
+            // failing ones are discarded
+            for (Size popIter = 0; popIter < population.size(); popIter++) {
+                try {
+                    population[popIter].cost =
+                        costFunction.value(population[popIter].values);
+                } catch (Error&) {
+                    population[popIter].cost = QL_MAX_REAL;
+                }
             }
         }
     }
@@ -354,15 +377,22 @@ namespace QuantLib {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
         }
+        Matrix candidates(population.size(), p.currentValue().size());
+        for (Size j = 0; j < population.size(); ++j) {
+            std::copy(population[j].values.begin(),
+                      population[j].values.end(),
+                      candidates.row_begin(j));
+        }
+        Array costs = p.costFunction().batchValue(candidates);
+        for (Size j = 0; j < population.size(); ++j)
+            population[j].cost = costs[j];
     }
 
 }
@@ -55,7 +55,12 @@ namespace QuantLib {
 
 
     //! %OptimizationMethod using Differential Evolution algorithm
-    /*! \ingroup optimizers */
+    /*! Each generation is evaluated with a single call to
+        CostFunction::batchValue, so that the candidates can be
+        evaluated concurrently by cost functions allowing it.
+
+        \ingroup optimizers
+    */
     class DifferentialEvolution: public OptimizationMethod {
       public:
         enum Strategy {
@@ -188,6 +193,9 @@ namespace QuantLib {
                        const std::vector<Candidate>& mutantPopulation,
                        const std::vector<Candidate>& mirrorPopulation,
                        const CostFunction& costFunction) const;
+
+        void evaluate(std::vector<Candidate>& population,
+                      const CostFunction& costFunction) const;
     };
 
 }
@@ -22,6 +22,13 @@
 #include <ql/math/optimization/lmdif.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/functional.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace QuantLib {
 
@@ -30,7 +37,8 @@ namespace QuantLib {
                                            Real gtol,
                                            bool useCostFunctionsJacobian)
         : info_(0), epsfcn_(epsfcn), xtol_(xtol), gtol_(gtol),
-          useCostFunctionsJacobian_(useCostFunctionsJacobian) {}
+          useCostFunctionsJacobian_(useCostFunctionsJacobian),
+          parallelJacobian_(false) {}
 
     Integer LevenbergMarquardt::getInfo() const {
         return info_;
@@ -51,23 +59,6 @@ namespace QuantLib {
             initJacobian_ = Matrix(m,n);
             P.costFunction().jacobian(initJacobian_, x_);
         }
-        boost::scoped_array<Real> xx(new Real[n]);
-        std::copy(x_.begin(), x_.end(), xx.get());
-        boost::scoped_array<Real> fvec(new Real[m]);
-        boost::scoped_array<Real> diag(new Real[n]);
-        int mode = 1;
-        Real factor = 1;
-        int nprint = 0;
-        int info = 0;
-        int nfev =0;
-        boost::scoped_array<Real> fjac(new Real[m*n]);
-        int ldfjac = m;
-        boost::scoped_array<int> ipvt(new int[n]);
-        boost::scoped_array<Real> qtf(new Real[n]);
-        boost::scoped_array<Real> wa1(new Real[n]);
-        boost::scoped_array<Real> wa2(new Real[n]);
-        boost::scoped_array<Real> wa3(new Real[n]);
-        boost::scoped_array<Real> wa4(new Real[m]);
         // requirements; check here to get more detailed error messages.
         QL_REQUIRE(n > 0, "no variables given");
         QL_REQUIRE(m >= n,
@@ -80,25 +71,52 @@ namespace QuantLib {
         QL_REQUIRE(endCriteria.maxIterations() > 0,
                    "null number of evaluations");
 
+        // the workspace is only reallocated if the size changed
+        xx_.resize(n);
+        std::copy(x_.begin(), x_.end(), xx_.begin());
+        fvec_.resize(m);
+        diag_.resize(n);
+        int mode = 1;
+        Real factor = 1;
+        int nprint = 0;
+        int info = 0;
+        int nfev =0;
+        fjac_.resize(m*n);
+        int ldfjac = m;
+        ipvt_.resize(n);
+        qtf_.resize(n);
+        wa1_.resize(n);
+        wa2_.resize(n);
+        wa3_.resize(n);
+        wa4_.resize(m);
+        Array().swap(lastPoint_);
+
         // call lmdif to minimize the sum of the squares of m functions
         // in n variables by the Levenberg-Marquardt algorithm.
         MINPACK::LmdifCostFunction lmdifCostFunction =
             ext::bind(&LevenbergMarquardt::fcn, this, _1, _2, _3, _4, _5);
-        MINPACK::LmdifCostFunction lmdifJacFunction =
-            useCostFunctionsJacobian_
-                ? ext::bind(&LevenbergMarquardt::jacFcn, this, _1, _2, _3,
-                              _4, _5)
-                : MINPACK::LmdifCostFunction();
-        MINPACK::lmdif(m, n, xx.get(), fvec.get(),
+        MINPACK::LmdifCostFunction lmdifJacFunction;
+        if (useCostFunctionsJacobian_) {
+            lmdifJacFunction = ext::bind(&LevenbergMarquardt::jacFcn, this,
+                                         _1, _2, _3, _4, _5);
+        }
+        #ifdef _OPENMP
+        else if (parallelJacobian_ &&
+                 P.costFunction().allowsConcurrentEvaluation()) {
+            lmdifJacFunction = ext::bind(&LevenbergMarquardt::fdJacFcn, this,
+                                         _1, _2, _3, _4, _5);
+        }
+        #endif
+        MINPACK::lmdif(m, n, &xx_[0], &fvec_[0],
                        endCriteria.functionEpsilon(),
                        xtol_,
                        gtol_,
                        endCriteria.maxIterations(),
                        epsfcn_,
-                       diag.get(), mode, factor,
-                       nprint, &info, &nfev, fjac.get(),
-                       ldfjac, ipvt.get(), qtf.get(),
-                       wa1.get(), wa2.get(), wa3.get(), wa4.get(),
+                       &diag_[0], mode, factor,
+                       nprint, &info, &nfev, &fjac_[0],
+                       ldfjac, &ipvt_[0], &qtf_[0],
+                       &wa1_[0], &wa2_[0], &wa3_[0], &wa4_[0],
                        lmdifCostFunction,
                        lmdifJacFunction);
         info_ = info;
@@ -118,24 +136,72 @@ namespace QuantLib {
                                        "orthogonal to the columns of the "
                                        "jacobian to machine precision.");
         // set problem
-        std::copy(xx.get(), xx.get()+n, x_.begin());
+        std::copy(xx_.begin(), xx_.end(), x_.begin());
         P.setCurrentValue(x_);
         P.setFunctionValue(P.costFunction().value(x_));
 
         return ecType;
     }
 
+    std::vector<EndCriteria::Type> LevenbergMarquardt::minimize(
+                        const std::vector<ext::shared_ptr<Problem> >& problems,
+                        const EndCriteria& endCriteria) {
+        const Size n = problems.size();
+        std::vector<EndCriteria::Type> ecTypes(n, EndCriteria::None);
+        std::vector<std::string> failures(n);
+
+        bool concurrent = true;
+        for (Size i=0; i<n && concurrent; ++i)
+            concurrent =
+                problems[i]->costFunction().allowsConcurrentEvaluation();
+
+        // exceptions can't cross the boundary of the parallel region;
+        // the one from the first failing problem is rethrown
+        #pragma omp parallel if(concurrent && n > 1)
+        {
+            // each thread needs its own state and workspace
+            LevenbergMarquardt lm(epsfcn_, xtol_, gtol_,
+                                  useCostFunctionsJacobian_);
+            lm.enableParallelJacobian(parallelJacobian_);
+            #ifdef _OPENMP
+            LevenbergMarquardt& method =
+                omp_in_parallel() ? lm : *this;
+            #else
+            LevenbergMarquardt& method = *this;
+            #endif
+            #pragma omp for schedule(dynamic)
+            for (long i=0; i<(long)n; ++i) {
+                try {
+                    ecTypes[i] = method.minimize(*problems[i], endCriteria);
+                } catch (std::exception& e) {
+                    failures[i] = e.what();
+                    if (failures[i].empty())
+                        failures[i] = "unknown error";
+                } catch (...) {
+                    failures[i] = "unknown error";
+                }
+            }
+        }
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(failures[i].empty(), failures[i]);
+        return ecTypes;
+    }
+
     void LevenbergMarquardt::fcn(int, int n, Real* x, Real* fvec, int*) {
-        Array xt(n);
-        std::copy(x, x+n, xt.begin());
+        xt_.resize(n);
+        std::copy(x, x+n, xt_.begin());
         // constraint handling needs some improvement in the future:
         // starting point should not be close to a constraint violation
-        if (currentProblem_->constraint().test(xt)) {
-            const Array& tmp = currentProblem_->values(xt);
+        if (currentProblem_->constraint().test(xt_)) {
+            const Array& tmp = currentProblem_->values(xt_);
             std::copy(tmp.begin(), tmp.end(), fvec);
         } else {
             std::copy(initCostValues_.begin(), initCostValues_.end(), fvec);
         }
+        if (parallelJacobian_) {
+            lastPoint_ = xt_;
+            lastValues_ = Array(fvec, fvec+initCostValues_.size());
+        }
     }
 
     void LevenbergMarquardt::jacFcn(int m, int n, Real* x, Real* fjac, int*) {
@@ -154,4 +220,54 @@ namespace QuantLib {
         }
     }
 
+    void LevenbergMarquardt::fdJacFcn(int m, int n, Real* x, Real* fjac,
+                                      int*) {
+        Array xt(x, x+n);
+
+        // lmdif evaluated the function at x already, unless the last
+        // step was rejected
+        if (lastPoint_ != xt) {
+            Array f(m);
+            int iflag = 0;
+            fcn(m, n, x, f.begin(), &iflag);
+        }
+        const Array& f0 = lastValues_;
+
+        // same step sizes as in MINPACK's fdjac2
+        const Real eps = std::sqrt(std::max(epsfcn_, 1.2e-16));
+        const CostFunction& costFunction = currentProblem_->costFunction();
+        const Constraint& constraint = currentProblem_->constraint();
+
+        // exceptions can't cross the boundary of the parallel region;
+        // the one from the first failing column is rethrown.  The cost
+        // function is called directly, so evaluations are counted here.
+        std::vector<std::string> failures(n);
+        std::vector<int> evaluated(n, 0);
+        #pragma omp parallel for schedule(dynamic)
+        for (long j=0; j<(long)n; ++j) {
+            try {
+                Array xj(xt);
+                Real h = eps*std::fabs(xj[j]);
+                if (h == 0.0)
+                    h = eps;
+                xj[j] += h;
+                evaluated[j] = constraint.test(xj) ? 1 : 0;
+                const Array fj = evaluated[j] != 0 ?
+                    costFunction.values(xj) : initCostValues_;
+                for (int i=0; i<m; ++i)
+                    fjac[i+m*j] = (fj[i]-f0[i])/h;
+            } catch (std::exception& e) {
+                failures[j] = e.what();
+                if (failures[j].empty())
+                    failures[j] = "unknown error";
+            } catch (...) {
+                failures[j] = "unknown error";
+            }
+        }
+        currentProblem_->addEvaluations(
+            std::accumulate(evaluated.begin(), evaluated.end(), 0));
+        for (int j=0; j<n; ++j)
+            QL_REQUIRE(failures[j].empty(), failures[j]);
+    }
+
 }
@@ -26,6 +26,7 @@
 #define quantlib_optimization_levenberg_marquardt_hpp
 
 #include <ql/math/optimization/problem.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -44,6 +45,22 @@ namespace QuantLib {
         evaluations) compared to the forward
         difference implemented here (order 1).
 
+        The workspace used by MINPACK is kept by
+        the instance and only reallocated when the
+        size of the problem changes; therefore,
+        many small problems of the same shape are
+        best minimized by reusing a single
+        instance, or by calling the overload of
+        minimize() taking a sequence of problems.
+
+        If the parallel jacobian is enabled and
+        the cost function allows concurrent
+        evaluation, the columns of the forward
+        difference jacobian are evaluated
+        concurrently when OpenMP is enabled. The
+        results are the same as in the serial
+        case.
+
         \ingroup optimizers
     */
     class LevenbergMarquardt : public OptimizationMethod {
@@ -56,7 +73,28 @@ namespace QuantLib {
                                            const EndCriteria& endCriteria //= EndCriteria()
                                            );
                                            //      = EndCriteria(400, 1.0e-8, 1.0e-8)
+        /*! minimizes a number of independent problems.  The problems
+            are minimized concurrently if OpenMP is enabled and all
+            their cost functions allow concurrent evaluation, each
+            thread reusing its own copy of the workspace; otherwise,
+            they are minimized one after the other.  If any of the
+            minimizations fails, the error of the first failing
+            problem is rethrown once all of them are done.
+        */
+        std::vector<EndCriteria::Type> minimize(
+                        const std::vector<ext::shared_ptr<Problem> >& problems,
+                        const EndCriteria& endCriteria);
         virtual Integer getInfo() const;
+
+        //! \name Parallel jacobian
+        //@{
+        void enableParallelJacobian(bool b = true) {
+            parallelJacobian_ = b;
+        }
+        void disableParallelJacobian() { parallelJacobian_ = false; }
+        bool allowsParallelJacobian() const { return parallelJacobian_; }
+        //@}
+
         void fcn(int m,
                  int n,
                  Real* x,
@@ -68,6 +106,12 @@ namespace QuantLib {
                  Real* fjac,
                  int* iflag);
 
+        void fdJacFcn(int m,
+                 int n,
+                 Real* x,
+                 Real* fjac,
+                 int* iflag);
+
       private:
         Problem* currentProblem_;
         Array initCostValues_;
@@ -75,6 +119,14 @@ namespace QuantLib {
         mutable Integer info_;
         const Real epsfcn_, xtol_, gtol_;
         bool useCostFunctionsJacobian_;
+        bool parallelJacobian_;
+        // MINPACK workspace, kept across minimizations
+        std::vector<Real> xx_, fvec_, diag_, fjac_, qtf_;
+        std::vector<Real> wa1_, wa2_, wa3_, wa4_;
+        std::vector<int> ipvt_;
+        // last point evaluated by fcn and the corresponding values,
+        // used by the parallel jacobian
+        Array xt_, lastPoint_, lastValues_;
     };
 
 }
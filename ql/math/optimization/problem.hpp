@@ -59,6 +59,10 @@ namespace QuantLib {
         //! call cost values computation and increment evaluation counter
         Disposable<Array> values(const Array& x);
 
+        //! call cost function computation for each row of the population
+        //  and increment evaluation counter accordingly
+        Disposable<Array> batchValue(const Matrix& population);
+
         //! call cost function gradient computation and increment
         //  evaluation counter
         void gradient(Array& grad_f,
@@ -100,6 +104,17 @@ namespace QuantLib {
         //! number of evaluation of cost function gradient
         Integer gradientEvaluation() const { return gradientEvaluation_; }
 
+        //! increment evaluation counters
+        /*! To be used by optimization methods that call the cost
+            function without going through this class, e.g., from
+            several threads at once.
+        */
+        void addEvaluations(Integer functionEvaluations,
+                            Integer gradientEvaluations = 0) {
+            functionEvaluation_ += functionEvaluations;
+            gradientEvaluation_ += gradientEvaluations;
+        }
+
       protected:
         //! Unconstrained cost function
         CostFunction& costFunction_;
@@ -124,6 +139,11 @@ namespace QuantLib {
         return costFunction_.values(x);
     }
 
+    inline Disposable<Array> Problem::batchValue(const Matrix& population) {
+        functionEvaluation_ += Integer(population.rows());
+        return costFunction_.batchValue(population);
+    }
+
     inline void Problem::gradient(Array& grad_f,
                                   const Array& x) {
         ++gradientEvaluation_;
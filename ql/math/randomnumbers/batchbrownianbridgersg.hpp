@@ -0,0 +1,131 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchbrownianbridgersg.hpp
+    \brief Gaussian sequence generator bridging blocks of paths
+*/
+
+#ifndef quantlib_batch_brownian_bridge_rsg_hpp
+#define quantlib_batch_brownian_bridge_rsg_hpp
+
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Gaussian sequence generator bridging blocks of paths
+    /*! Gaussian sequences are drawn in blocks from the underlying
+        generator and are passed through a Brownian bridge all at
+        once (see BrownianBridge::transform(const Matrix&, Matrix&));
+        the bridged sequences are then returned one at a time.
+
+        The returned sequences are the same that would be obtained by
+        bridging the output of the underlying generator one sequence
+        at a time. Therefore, the generator can be passed to a
+        PathGenerator built on the same time grid with
+        <tt>brownianBridge = false</tt> to obtain the same paths as a
+        PathGenerator using the underlying generator and
+        <tt>brownianBridge = true</tt>.
+
+        Class GSG must implement the following interface:
+        \code
+            GSG::sample_type GSG::nextSequence() const;
+            Size GSG::dimension() const;
+        \endcode
+
+        \ingroup mcarlo
+    */
+    template <class GSG>
+    class BatchBrownianBridgeRsg {
+      public:
+        typedef Sample<std::vector<Real> > sample_type;
+        BatchBrownianBridgeRsg(const GSG& generator,
+                               const BrownianBridge& bridge,
+                               Size blockSize = 64);
+        //! returns the next bridged sequence
+        const sample_type& nextSequence() const;
+        const sample_type& lastSequence() const { return x_; }
+        Size dimension() const { return dimension_; }
+        //! fills the next block of bridged sequences, one per column
+        /*! The returned block is no longer valid after the next call
+            to either nextBlock() or nextSequence().
+        */
+        const Matrix& nextBlock() const;
+        //! weights of the sequences in the last block
+        const std::vector<Real>& blockWeights() const { return weights_; }
+        Size blockSize() const { return blockSize_; }
+      private:
+        GSG generator_;
+        BrownianBridge bridge_;
+        Size dimension_, blockSize_;
+        mutable Matrix variates_, bridged_;
+        mutable std::vector<Real> weights_;
+        mutable Size next_;
+        mutable sample_type x_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    BatchBrownianBridgeRsg<GSG>::BatchBrownianBridgeRsg(
+                                                const GSG& generator,
+                                                const BrownianBridge& bridge,
+                                                Size blockSize)
+    : generator_(generator), bridge_(bridge),
+      dimension_(generator_.dimension()), blockSize_(blockSize),
+      variates_(dimension_, blockSize_), bridged_(dimension_, blockSize_),
+      weights_(blockSize_), next_(blockSize_),
+      x_(std::vector<Real>(dimension_), 1.0) {
+        QL_REQUIRE(dimension_ == bridge_.size(),
+                   "sequence generator dimensionality (" << dimension_
+                   << ") != bridge size (" << bridge_.size() << ")");
+        QL_REQUIRE(blockSize_ > 0, "null block size given");
+    }
+
+    template <class GSG>
+    const Matrix& BatchBrownianBridgeRsg<GSG>::nextBlock() const {
+        for (Size j=0; j<blockSize_; ++j) {
+            const typename GSG::sample_type& sample =
+                generator_.nextSequence();
+            weights_[j] = sample.weight;
+            for (Size i=0; i<dimension_; ++i)
+                variates_[i][j] = sample.value[i];
+        }
+        bridge_.transform(variates_, bridged_);
+        next_ = blockSize_;
+        return bridged_;
+    }
+
+    template <class GSG>
+    inline const typename BatchBrownianBridgeRsg<GSG>::sample_type&
+    BatchBrownianBridgeRsg<GSG>::nextSequence() const {
+        if (next_ == blockSize_) {
+            nextBlock();
+            next_ = 0;
+        }
+        x_.weight = weights_[next_];
+        for (Size i=0; i<dimension_; ++i)
+            x_.value[i] = bridged_[i][next_];
+        ++next_;
+        return x_;
+    }
+
+}
+
+
+#endif
@@ -26,10 +26,33 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
 #include <vector>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        template <class IC, class Sequence>
+        inline void inverseCumulativeTransform(const IC& ic,
+                                               const Sequence& input,
+                                               std::vector<Real>& output) {
+            for (Size i = 0; i < output.size(); i++)
+                output[i] = ic(input[i]);
+        }
+
+        // the normal distribution can transform the whole sequence
+        // at once
+        inline void inverseCumulativeTransform(
+                                        const InverseCumulativeNormal& ic,
+                                        const std::vector<Real>& input,
+                                        std::vector<Real>& output) {
+            if (!output.empty())
+                ic(&input[0], &input[0]+output.size(), &output[0]);
+        }
+
+    }
+
     //! Inverse cumulative random sequence generator
     /*! It uses a sequence of uniform deviate in (0, 1) as the
         source of cumulative distribution values.
@@ -62,6 +85,8 @@ namespace QuantLib {
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
         const sample_type& lastSequence() const { return x_; }
+        //! available only if USG implements a skipTo(n) method
+        void skipTo(BigNatural n) { uniformSequenceGenerator_.skipTo(n); }
         Size dimension() const { return dimension_; }
       private:
         USG uniformSequenceGenerator_;
@@ -90,9 +115,7 @@ namespace QuantLib {
         typename USG::sample_type sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
-        for (Size i = 0; i < dimension_; i++) {
-            x_.value[i] = ICD_(sample.value[i]);
-        }
+        detail::inverseCumulativeTransform(ICD_, sample.value, x_.value);
         return x_;
     }
 
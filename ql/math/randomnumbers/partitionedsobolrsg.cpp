@@ -0,0 +1,69 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/partitionedsobolrsg.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    PartitionedSobolRsg::PartitionedSobolRsg(
+                                 Size dimensionality,
+                                 unsigned long seed,
+                                 SobolRsg::DirectionIntegers directionIntegers,
+                                 Size partitions)
+    : prototype_(dimensionality, seed, directionIntegers),
+      partitions_(partitions), counter_(0) {
+        if (partitions_ == 0) {
+            #ifdef _OPENMP
+            partitions_ = omp_get_max_threads();
+            #else
+            partitions_ = 1;
+            #endif
+        }
+    }
+
+    void PartitionedSobolRsg::sequences(boost::uint_least32_t first,
+                                        Matrix& output) const {
+        const Size n = output.rows();
+        QL_REQUIRE(output.columns() == dimension(),
+                   "output columns (" << output.columns()
+                   << ") != dimension (" << dimension() << ")");
+        QL_REQUIRE(boost::uint_least32_t(first + n) >= first,
+                   "period exceeded");
+        if (n == 0)
+            return;
+
+        const Size blocks = std::min(partitions_, n);
+
+        #pragma omp parallel for
+        for (long i=0; i<(long)blocks; ++i) {
+            const Size begin = (i*n)/blocks;
+            const Size end = ((i+1)*n)/blocks;
+            SobolRsg rsg(prototype_);
+            rsg.skipTo(first + boost::uint_least32_t(begin));
+            rsg.nextSequences(end-begin, output.row_begin(begin));
+        }
+    }
+
+    void PartitionedSobolRsg::nextSequences(Matrix& output) const {
+        sequences(counter_, output);
+        counter_ += boost::uint_least32_t(output.rows());
+    }
+
+}
@@ -0,0 +1,82 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file partitionedsobolrsg.hpp
+    \brief Sobol sequence generated over disjoint contiguous blocks
+*/
+
+#ifndef quantlib_partitioned_sobol_rsg_hpp
+#define quantlib_partitioned_sobol_rsg_hpp
+
+#include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! Sobol sequence generated over disjoint contiguous blocks
+    /*! The requested points are split into contiguous blocks, one
+        for each partition. Each block is filled by its own copy of a
+        Sobol generator, which is moved to the start of the block by
+        means of SobolRsg::skipTo (at a cost proportional to the
+        dimension times the logarithm of the index) and then advanced
+        by Gray-code updates. When OpenMP is enabled, the blocks are
+        generated concurrently.
+
+        Since each point only depends on its index, the output is the
+        same as the serial sequence returned by SobolRsg for the same
+        dimensionality, seed and direction integers, whatever the
+        number of partitions or threads.
+
+        \test the generated points are checked against the serial
+              sequence for several partitions.
+    */
+    class PartitionedSobolRsg {
+      public:
+        /*! \param partitions the number of blocks in which each
+                              request is split; if null, one for each
+                              available thread is used.
+        */
+        PartitionedSobolRsg(Size dimensionality,
+                            unsigned long seed = 0,
+                            SobolRsg::DirectionIntegers directionIntegers
+                                                        = SobolRsg::Jaeckel,
+                            Size partitions = 0);
+        /*! fills each row of the output with a point of the sequence,
+            starting from the one with the given index; index 0
+            corresponds to the first point returned by a newly built
+            SobolRsg.
+        */
+        void sequences(boost::uint_least32_t first, Matrix& output) const;
+        /*! fills each row of the output with the next point of the
+            sequence
+        */
+        void nextSequences(Matrix& output) const;
+        /*! skip to the n-th sample in the low-discrepancy sequence */
+        void skipTo(boost::uint_least32_t n) { counter_ = n; }
+        Size dimension() const { return prototype_.dimension(); }
+        Size partitions() const { return partitions_; }
+      private:
+        // never drawn from; each block starts from a copy of it
+        SobolRsg prototype_;
+        Size partitions_;
+        mutable boost::uint_least32_t counter_;
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,57 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/randomnumbers/philox4x32uniformrng.hpp>
+#include <ql/math/randomnumbers/seedgenerator.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        void setKey(boost::uint32_t key[2], unsigned long seed) {
+            boost::uint64_t s = (seed != 0 ? seed :
+                                 SeedGenerator::instance().get());
+            key[0] = boost::uint32_t(s);
+            key[1] = boost::uint32_t(s >> 32);
+        }
+
+    }
+
+    Philox4x32UniformRng::Philox4x32UniformRng(unsigned long seed)
+    : stream_(0), block_(0), position_(4) {
+        setKey(key_, seed);
+    }
+
+    Philox4x32UniformRng::Philox4x32UniformRng(unsigned long seed,
+                                               boost::uint64_t stream)
+    : stream_(stream), block_(0), position_(4) {
+        setKey(key_, seed);
+    }
+
+    void Philox4x32UniformRng::skipTo(boost::uint64_t n) {
+        block_ = n/4;
+        generateBlock();
+        position_ = Size(n%4);
+    }
+
+    void Philox4x32UniformRng::setStream(boost::uint64_t stream) {
+        stream_ = stream;
+        block_ = 0;
+        position_ = 4;
+    }
+
+}
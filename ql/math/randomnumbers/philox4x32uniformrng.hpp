@@ -0,0 +1,144 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file philox4x32uniformrng.hpp
+    \brief Philox-4x32-10 counter-based uniform random number generator
+*/
+
+#ifndef quantlib_philox4x32_uniform_rng_hpp
+#define quantlib_philox4x32_uniform_rng_hpp
+
+#include <ql/methods/montecarlo/sample.hpp>
+#include <boost/cstdint.hpp>
+
+namespace QuantLib {
+
+    //! Counter-based uniform random number generator
+    /*! Philox-4x32-10 generator by Salmon, Moraes, Dror and Shaw.
+        Each block of four 32-bit outputs is obtained by applying ten
+        rounds of a keyed bijection to a 128-bit counter; the key is
+        given by the seed, while the counter holds the stream number
+        (upper 64 bits) and the index of the block within the stream
+        (lower 64 bits).
+
+        Since no state is carried from one block to the next, the
+        generator can be moved to any position of any stream in
+        constant time. This allows to give each trade, path or thread
+        its own reproducible stream without seeding heuristics.
+
+        For more details see J. K. Salmon, M. A. Moraes, R. O. Dror,
+        D. E. Shaw, "Parallel random numbers: as easy as 1, 2, 3",
+        Proceedings of SC11, 2011.
+
+        \test the correctness of the returned values is tested by
+              checking them against known good results.
+    */
+    class Philox4x32UniformRng {
+      public:
+        typedef Sample<Real> sample_type;
+        /*! if the given seed is 0, a random seed will be chosen
+            based on clock() */
+        explicit Philox4x32UniformRng(unsigned long seed = 0);
+        //! generator for the given stream
+        Philox4x32UniformRng(unsigned long seed,
+                             boost::uint64_t stream);
+        /*! returns a sample with weight 1.0 containing a random number
+            in the (0.0, 1.0) interval  */
+        sample_type next() const { return sample_type(nextReal(),1.0); }
+        //! return a random number in the (0.0, 1.0)-interval
+        Real nextReal() const {
+            return (Real(nextInt32()) + 0.5)/4294967296.0;
+        }
+        //! return a random integer in the [0,0xffffffff]-interval
+        unsigned long nextInt32() const {
+            if (position_ == 4)
+                generateBlock();
+            return buffer_[position_++];
+        }
+        /*! fills the output range with the next \f$ n \f$ random
+            numbers in the (0.0, 1.0) interval */
+        template <class Iterator>
+        void nextReals(Size n, Iterator output) const {
+            for (Size i=0; i<n; ++i, ++output)
+                *output = nextReal();
+        }
+        //! moves to the n-th output of the current stream
+        void skipTo(boost::uint64_t n);
+        //! moves to the beginning of the given stream
+        void setStream(boost::uint64_t stream);
+        boost::uint64_t stream() const { return stream_; }
+        //! the raw Philox-4x32-10 bijection
+        static void philox(const boost::uint32_t counter[4],
+                           const boost::uint32_t key[2],
+                           boost::uint32_t output[4]);
+      private:
+        void generateBlock() const;
+        boost::uint32_t key_[2];
+        boost::uint64_t stream_;
+        mutable boost::uint64_t block_;
+        mutable boost::uint32_t buffer_[4];
+        mutable Size position_;
+    };
+
+    // inline definitions
+
+    inline void Philox4x32UniformRng::generateBlock() const {
+        boost::uint32_t counter[4] = {
+            boost::uint32_t(block_), boost::uint32_t(block_ >> 32),
+            boost::uint32_t(stream_), boost::uint32_t(stream_ >> 32)
+        };
+        philox(counter, key_, buffer_);
+        ++block_;
+        position_ = 0;
+    }
+
+    inline void Philox4x32UniformRng::philox(
+                                        const boost::uint32_t counter[4],
+                                        const boost::uint32_t key[2],
+                                        boost::uint32_t output[4]) {
+        const boost::uint32_t M0 = 0xD2511F53U, M1 = 0xCD9E8D57U;
+        const boost::uint32_t W0 = 0x9E3779B9U, W1 = 0xBB67AE85U;
+
+        boost::uint32_t c0 = counter[0], c1 = counter[1],
+                        c2 = counter[2], c3 = counter[3];
+        boost::uint32_t k0 = key[0], k1 = key[1];
+        for (Size round=0; round<10; ++round) {
+            if (round > 0) {
+                k0 += W0;
+                k1 += W1;
+            }
+            boost::uint64_t p0 = boost::uint64_t(M0) * c0;
+            boost::uint64_t p1 = boost::uint64_t(M1) * c2;
+            boost::uint32_t hi0 = boost::uint32_t(p0 >> 32),
+                            lo0 = boost::uint32_t(p0);
+            boost::uint32_t hi1 = boost::uint32_t(p1 >> 32),
+                            lo1 = boost::uint32_t(p1);
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+        }
+        output[0] = c0;
+        output[1] = c1;
+        output[2] = c2;
+        output[3] = c3;
+    }
+
+}
+
+
+#endif
@@ -83,6 +83,16 @@ namespace QuantLib {
         const sample_type& lastSequence() const {
             return sequence_;
         }
+        /*! moves to the n-th sequence; available only if class RNG
+            implements
+            \code
+                void RNG::skipTo(n);
+            \endcode
+            as counter-based generators do.
+        */
+        void skipTo(BigNatural n) {
+            rng_.skipTo(n*dimensionality_);
+        }
         Size dimension() const {return dimensionality_;}
       private:
         Size dimensionality_;
@@ -28,6 +28,7 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/philox4x32uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
@@ -77,6 +78,21 @@ namespace QuantLib {
     typedef GenericPseudoRandom<MersenneTwisterUniformRng,
                                 InverseCumulativePoisson> PoissonPseudoRandom;
 
+    //! traits for counter-based pseudo-random number generation
+    /*! The seed passed to make_sequence_generator selects the key of
+        the generator (e.g., a trade identifier); the returned
+        generator can then be moved to any path in constant time by
+        means of its skipTo method, so that each path can be
+        reproduced independently of the others.
+
+        \test sequence generators are generated and tested by
+              checking that skipping to a given path reproduces the
+              sequential draws.
+    */
+    typedef GenericPseudoRandom<Philox4x32UniformRng,
+                                InverseCumulativeNormal>
+                                                    CounterBasedPseudoRandom;
+
 
     template <class URSG, class IC>
     struct GenericLowDiscrepancy {
@@ -129,6 +129,30 @@ namespace QuantLib {
                 sequence_.value[k] = v[k] * normalizationFactor_;
             return sequence_;
         }
+        /*! fills the output range with the next \f$ n \f$ points
+            of the sequence, one after the other; the range must
+            hold \f$ n \f$ times dimension() elements.
+
+            The result is the same as calling nextSequence()
+            \f$ n \f$ times, but each point is written directly
+            from the Gray-code update, which runs over all dimensions
+            at once, without going through the sample buffer.
+            Afterwards, lastSequence() returns the last point.
+        */
+        template <class Iterator>
+        void nextSequences(Size n, Iterator output) const {
+            for (Size i=0; i<n; ++i) {
+                const std::vector<boost::uint_least32_t>& v =
+                    nextInt32Sequence();
+                for (Size k=0; k<dimensionality_; ++k, ++output)
+                    *output = v[k] * normalizationFactor_;
+            }
+            if (n > 0) {
+                for (Size k=0; k<dimensionality_; ++k)
+                    sequence_.value[k] =
+                        integerSequence_[k] * normalizationFactor_;
+            }
+        }
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
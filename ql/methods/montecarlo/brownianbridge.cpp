@@ -109,5 +109,61 @@ namespace QuantLib {
         }
     }
 
-}
+    void BrownianBridge::transform(const Matrix& input,
+                                   Matrix& output) const {
+        QL_REQUIRE(input.rows() == size_,
+                   "incompatible sequence size");
+        QL_REQUIRE(output.rows() == size_ &&
+                   output.columns() == input.columns(),
+                   "incompatible output size");
+        QL_REQUIRE(&input != &output,
+                   "input and output must be different matrices");
+
+        const Size n = input.columns();
+        if (n == 0)
+            return;
+
+        // We use output to store the paths...
+        const Real* in = input.row_begin(0);
+        Real* out = output.row_begin(size_-1);
+        const Real sigma0 = stdDev_[0];
+        for (Size p=0; p<n; ++p)
+            out[p] = sigma0 * in[p];
+
+        for (Size i=1; i<size_; ++i) {
+            Size j = leftIndex_[i];
+            Size k = rightIndex_[i];
+            Size l = bridgeIndex_[i];
+            in = input.row_begin(i);
+            out = output.row_begin(l);
+            const Real* right = output.row_begin(k);
+            const Real wr = rightWeight_[i], sigma = stdDev_[i];
+            if (j != 0) {
+                const Real* left = output.row_begin(j-1);
+                const Real wl = leftWeight_[i];
+                for (Size p=0; p<n; ++p)
+                    out[p] = wl * left[p] + wr * right[p] + sigma * in[p];
+            } else {
+                for (Size p=0; p<n; ++p)
+                    out[p] = wr * right[p] + sigma * in[p];
+            }
+        }
 
+        // ...after which, we calculate the variations and
+        // normalize to unit times
+        for (Size i=size_-1; i>=1; --i) {
+            out = output.row_begin(i);
+            const Real* previous = output.row_begin(i-1);
+            const Real dt = sqrtdt_[i];
+            for (Size p=0; p<n; ++p) {
+                out[p] -= previous[p];
+                out[p] /= dt;
+            }
+        }
+        out = output.row_begin(0);
+        const Real dt0 = sqrtdt_[0];
+        for (Size p=0; p<n; ++p)
+            out[p] /= dt0;
+    }
+
+}
@@ -38,6 +38,7 @@
 
 #include <ql/methods/montecarlo/path.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -135,6 +136,25 @@ namespace QuantLib {
             }
             output[0] /= sqrtdt_[0];
         }
+
+        //! Brownian-bridge generator function for a block of paths
+        /*! Transforms a block of input sequences at once. Each row
+            of the input matrix holds the same variate for all the
+            paths in the block, i.e., each column is a sequence; the
+            output is laid out in the same way. Since the
+            construction order is the same for all paths, the inner
+            loops run over contiguous memory across the block and can
+            be vectorized by the compiler.
+
+            \param input  a size() x n matrix of random variates.
+            \param output a size() x n matrix; it must not be the
+                          same object as the input.
+
+            \note Column i of the output is equal to the result of
+                  the iterator version applied to column i of the
+                  input.
+        */
+        void transform(const Matrix& input, Matrix& output) const;
       private:
         void initialize();
         Size size_;
@@ -84,4 +84,50 @@ namespace QuantLib {
         
         return error;
     }
+
+    Disposable<Array> BlackCalibrationHelper::modelValueGradient() const {
+        Array gradient;
+        return gradient;
+    }
+
+    Disposable<Array> BlackCalibrationHelper::calibrationErrorGradient() {
+        Array gradient = modelValueGradient();
+        if (gradient.empty())
+            return gradient;
+
+        switch (calibrationErrorType_) {
+          case RelativePriceError:
+            gradient *= (modelValue() >= marketValue() ? 1.0 : -1.0)
+                        / marketValue();
+            break;
+          case PriceError:
+            gradient *= -1.0;
+            break;
+          case ImpliedVolError:
+            {
+              Real minVol = volatilityType_ == ShiftedLognormal ? 0.0010 : 0.00005;
+              Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
+              const Real lowerPrice = blackPrice(minVol);
+              const Real upperPrice = blackPrice(maxVol);
+              const Real modelPrice = modelValue();
+
+              if (modelPrice <= lowerPrice || modelPrice >= upperPrice) {
+                  // the error is floored or capped
+                  gradient *= 0.0;
+              } else {
+                  const Volatility implied = this->impliedVolatility(
+                                      modelPrice, 1e-12, 5000, minVol, maxVol);
+                  const Real h = 1e-4*implied;
+                  const Real vega =
+                      (blackPrice(implied+h) - blackPrice(implied-h))/(2*h);
+                  gradient /= vega;
+              }
+            }
+            break;
+          default:
+            QL_FAIL("unknown Calibration Error Type");
+        }
+
+        return gradient;
+    }
 }
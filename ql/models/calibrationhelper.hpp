@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/array.hpp>
 #include <list>
 
 namespace QuantLib {
@@ -77,6 +78,11 @@ namespace QuantLib {
         //! returns the volatility type
         VolatilityType volatilityType() const { return volatilityType_; }
 
+        //! returns the type of calibration error
+        CalibrationErrorType calibrationErrorType() const {
+            return calibrationErrorType_;
+        }
+
         //! returns the actual price of the instrument (from volatility)
         Real marketValue() const { calculate(); return marketValue_; }
 
@@ -86,6 +92,17 @@ namespace QuantLib {
         //! returns the error resulting from the model valuation
         Real calibrationError();
 
+        //! derivatives of the model price with respect to the model parameters
+        /*! Helpers whose pricing engine can calculate them should
+            override this method; the default implementation returns
+            an empty array, meaning that they are not available.
+        */
+        virtual Disposable<Array> modelValueGradient() const;
+
+        //! derivatives of the calibration error with respect to the model parameters
+        /*! Returns an empty array if modelValueGradient() does. */
+        Disposable<Array> calibrationErrorGradient();
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -98,9 +115,20 @@ namespace QuantLib {
         //! Black or Bachelier price given a volatility
         virtual Real blackPrice(Volatility volatility) const = 0;
 
+        //! whether Black prices can be calculated concurrently
+        /*! Helpers should return true only if blackPrice() doesn't
+            create observers of observables shared with other
+            helpers (such as engines registering with the discount
+            curve) and doesn't modify shared objects otherwise.
+        */
+        virtual bool concurrentBlackPrices() const { return false; }
+
         void setPricingEngine(const ext::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        const ext::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         mutable Real marketValue_;
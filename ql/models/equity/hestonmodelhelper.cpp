@@ -21,6 +21,7 @@
 
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/instruments/payoffs.hpp>
 #include <ql/quotes/simplequote.hpp>
@@ -83,6 +84,20 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    Disposable<Array> HestonModelHelper::modelValueGradient() const {
+        calculate();
+        ext::shared_ptr<AnalyticHestonEngine> engine =
+            ext::dynamic_pointer_cast<AnalyticHestonEngine>(engine_);
+        if (!engine || !engine->providesValueGradient()) {
+            Array gradient;
+            return gradient;
+        }
+
+        VanillaOption::arguments arguments;
+        option_->setupArguments(&arguments);
+        return engine->valueGradient(arguments);
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
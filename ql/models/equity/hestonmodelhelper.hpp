@@ -56,7 +56,16 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const {}
         void performCalculations() const;
         Real modelValue() const;
+        /*! Available when the pricing engine is an AnalyticHestonEngine
+            providing the value gradient; the derivatives are then
+            used by the calibration as the Jacobian of the cost
+            function, e.g., by LevenbergMarquardt when created with
+            useCostFunctionsJacobian = true.
+        */
+        Disposable<Array> modelValueGradient() const;
         Real blackPrice(Real volatility) const;
+        //! Black prices are given by the Black formula
+        bool concurrentBlackPrices() const { return true; }
         Time maturity() const  { calculate(); return tau_; }
       private:
         const Period maturity_;
@@ -112,13 +112,22 @@ namespace QuantLib {
                                         Size steps,
                                         Ordering ordering,
                                         unsigned long seed,
-                                        SobolRsg::DirectionIntegers integers)
+                                        SobolRsg::DirectionIntegers integers,
+                                        Size blockSize)
     : factors_(factors), steps_(steps), ordering_(ordering),
       generator_(SobolRsg(factors*steps, seed, integers),
                  InverseCumulativeNormal()),
-      bridge_(steps), lastStep_(0),
+      bridge_(steps), blockSize_(blockSize), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
-      bridgedVariates_(factors, std::vector<Real>(steps)) {
+      bridgedVariates_(factors, std::vector<Real>(steps)),
+      lastPath_(blockSize) {
+
+        QL_REQUIRE(blockSize_ > 0, "null block size given");
+        if (blockSize_ > 1) {
+            orderedBlock_.resize(factors_, Matrix(steps_, blockSize_));
+            bridgedBlock_.resize(factors_, Matrix(steps_, blockSize_));
+            blockWeights_.resize(blockSize_);
+        }
 
         switch (ordering_) {
           case Factors:
@@ -141,6 +150,16 @@ namespace QuantLib {
                                      InverseCumulativeNormal>::sample_type
             sample_type;
 
+        if (blockSize_ > 1) {
+            if (lastPath_ == blockSize_)
+                nextBlock();
+            for (Size i=0; i<factors_; ++i)
+                for (Size j=0; j<steps_; ++j)
+                    bridgedVariates_[i][j] = bridgedBlock_[i][j][lastPath_];
+            lastStep_ = 0;
+            return blockWeights_[lastPath_++];
+        }
+
         const sample_type& sample = generator_.nextSequence();
         // Brownian-bridge the variates according to the ordered indices
         for (Size i=0; i<factors_; ++i) {
@@ -155,6 +174,27 @@ namespace QuantLib {
         lastStep_ = 0;
         return sample.weight;
     }
+
+    void SobolBrownianGenerator::nextBlock() {
+        typedef InverseCumulativeRsg<SobolRsg,
+                                     InverseCumulativeNormal>::sample_type
+            sample_type;
+
+        // gather the variates of each factor so that each row holds
+        // a given step for all the paths in the block...
+        for (Size k=0; k<blockSize_; ++k) {
+            const sample_type& sample = generator_.nextSequence();
+            blockWeights_[k] = sample.weight;
+            for (Size i=0; i<factors_; ++i)
+                for (Size j=0; j<steps_; ++j)
+                    orderedBlock_[i][j][k] =
+                        sample.value[orderedIndices_[i][j]];
+        }
+        // ...and bridge the whole block at once
+        for (Size i=0; i<factors_; ++i)
+            bridge_.transform(orderedBlock_[i], bridgedBlock_[i]);
+        lastPath_ = 0;
+    }
     
     
     const std::vector<std::vector<Size> >& 
@@ -168,26 +208,23 @@ namespace QuantLib {
         QL_REQUIRE(   (variates.size() == factors_*steps_),
                    "inconsistent variate vector");
 
-        const Size dim    = factors_*steps_;
         const Size nPaths = variates.front().size();
-        
+
         std::vector<std::vector<Real> > 
                        retVal(factors_, std::vector<Real>(nPaths*steps_));
-        
-        for (Size j=0; j < nPaths; ++j) {
-            std::vector<Real> sample(steps_*factors_);
-            for (Size k=0; k < dim; ++k) {
-                sample[k] = variates[k][j];
-            }
-            for (Size i=0; i<factors_; ++i) {
-                bridge_.transform(boost::make_permutation_iterator(
-                                                  sample.begin(),
-                                                  orderedIndices_[i].begin()),
-                          boost::make_permutation_iterator(
-                                                  sample.begin(),
-                                                  orderedIndices_[i].end()),
-                          retVal[i].begin()+j*steps_);
-            }
+
+        // each variate vector already holds a given dimension for
+        // all the paths, so that the whole set can be bridged at once
+        Matrix ordered(steps_, nPaths), bridged(steps_, nPaths);
+        for (Size i=0; i<factors_; ++i) {
+            for (Size j=0; j<steps_; ++j)
+                std::copy(variates[orderedIndices_[i][j]].begin(),
+                          variates[orderedIndices_[i][j]].end(),
+                          ordered.row_begin(j));
+            bridge_.transform(ordered, bridged);
+            for (Size k=0; k<nPaths; ++k)
+                for (Size j=0; j<steps_; ++j)
+                    retVal[i][k*steps_+j] = bridged[j][k];
         }
         
         return retVal;
@@ -213,14 +250,17 @@ namespace QuantLib {
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
                                     SobolBrownianGenerator::Ordering ordering,
                                     unsigned long seed,
-                                    SobolRsg::DirectionIntegers integers)
-    : ordering_(ordering), seed_(seed), integers_(integers) {}
+                                    SobolRsg::DirectionIntegers integers,
+                                    Size blockSize)
+    : ordering_(ordering), seed_(seed), integers_(integers),
+      blockSize_(blockSize) {}
 
     ext::shared_ptr<BrownianGenerator>
     SobolBrownianGeneratorFactory::create(Size factors, Size steps) const {
         return ext::shared_ptr<BrownianGenerator>(
                          new SobolBrownianGenerator(factors, steps, ordering_,
-                                                    seed_, integers_));
+                                                    seed_, integers_,
+                                                    blockSize_));
     }
 
 }
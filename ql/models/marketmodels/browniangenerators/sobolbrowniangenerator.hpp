@@ -33,6 +33,11 @@ namespace QuantLib {
     //! Sobol Brownian generator for market-model simulations
     /*! Incremental Brownian generator using a Sobol generator,
         inverse-cumulative Gaussian method, and Brownian bridging.
+
+        If a block size larger than one is passed, the Sobol points
+        are drawn and bridged in blocks of paths (see
+        BrownianBridge::transform(const Matrix&, Matrix&)); the
+        generated paths are the same as in the default case.
     */
     class SobolBrownianGenerator : public BrownianGenerator {
       public:
@@ -52,7 +57,8 @@ namespace QuantLib {
                            Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                        = SobolRsg::Jaeckel);
+                                                        = SobolRsg::Jaeckel,
+                           Size blockSize = 1);
 
         Real nextPath();
         Real nextStep(std::vector<Real>&);
@@ -66,14 +72,20 @@ namespace QuantLib {
                               const std::vector<std::vector<Real> >& variates);
 
       private:
+        void nextBlock();
         Size factors_, steps_;
         Ordering ordering_;
         InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator_;
         BrownianBridge bridge_;
+        Size blockSize_;
         // work variables
         Size lastStep_;
         std::vector<std::vector<Size> > orderedIndices_;
         std::vector<std::vector<Real> > bridgedVariates_;
+        // block variables, one steps x blockSize matrix per factor
+        Size lastPath_;
+        std::vector<Matrix> orderedBlock_, bridgedBlock_;
+        std::vector<Real> blockWeights_;
     };
 
     class SobolBrownianGeneratorFactory : public BrownianGeneratorFactory {
@@ -82,13 +94,15 @@ namespace QuantLib {
                            SobolBrownianGenerator::Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                         = SobolRsg::Jaeckel);
+                                                         = SobolRsg::Jaeckel,
+                           Size blockSize = 1);
         ext::shared_ptr<BrownianGenerator> create(Size factors,
                                                     Size steps) const;
       private:
         SobolBrownianGenerator::Ordering ordering_;
         unsigned long seed_;
         SobolRsg::DirectionIntegers integers_;
+        Size blockSize_;
     };
 
 }
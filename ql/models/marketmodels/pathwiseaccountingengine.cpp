@@ -346,6 +346,7 @@ namespace QuantLib {
 
         numberRates_ = pseudoRootStructure_->numberOfRates();
         numberSteps_ = pseudoRootStructure_->numberOfSteps();
+        factors_ = pseudoRootStructure_->numberOfFactors();
         fullDerivatives_.resize(numberRates_);
 
 
@@ -361,14 +362,26 @@ namespace QuantLib {
         {
             Size thisSize = vegaBumps[i].size();
             QL_REQUIRE(thisSize == numberBumps_,"We must have precisely the same number of bumps for each step.");
-            jacobianComputers_.push_back(RatePseudoRootJacobian(pseudoRootStructure_->pseudoRoot(i),evolution.firstAliveRate()[i],
+            for (Size j=0; j < numberBumps_; ++j)
+            {
+                QL_REQUIRE(vegaBumps[i][j].rows() == numberRates_,
+                    "vegaBumps[i][j].rows()<> number of rates with i = " << i << " and j = " << j);
+                QL_REQUIRE(vegaBumps[i][j].columns() == factors_,
+                    "vegaBumps[i][j].columns()<> number of factors with i = " << i << " and j = " << j);
+            }
+            jacobianComputers_.push_back(RatePseudoRootJacobianAllElements(pseudoRootStructure_->pseudoRoot(i),evolution.firstAliveRate()[i],
                                 numeraires_[i],
                                 evolution.rateTaus(),
-                                vegaBumps[i], pseudoRootStructure_->displacements()));
+                                pseudoRootStructure_->displacements()));
+        }
 
-            jacobiansThisPaths_.push_back(Matrix(numberBumps_,pseudoRootStructure_->numberOfRates()));
+        vegaBumps_ = vegaBumps;
 
-        }
+        forwardsThisPath_.resize(numberSteps_+1, std::vector<Real>(numberRates_));
+        stepsDiscountsThisPath_.resize(numberSteps_, std::vector<Real>(numberRates_+1));
+        gaussiansThisPath_.resize(numberSteps_, std::vector<Real>(factors_));
+        rateAdjoints_.resize(numberRates_);
+        pseudoRootAdjoints_ = Matrix(numberRates_, factors_);
 
 
 
@@ -503,11 +516,11 @@ namespace QuantLib {
                 Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
             }
 
-            jacobianComputers_[thisStep].getBumps(lastForwards_,
-                                         stepsDiscounts_,
-                                         currentForwards_,
-                                         evolver_->browniansThisStep(),
-                                         jacobiansThisPaths_[thisStep]);
+            // store what the adjoint sweep will need for this step
+            forwardsThisPath_[thisStep] = lastForwards_;
+            forwardsThisPath_[storeStep] = currentForwards_;
+            stepsDiscountsThisPath_[thisStep] = stepsDiscounts_;
+            gaussiansThisPath_[thisStep] = evolver_->browniansThisStep();
 
 
 
@@ -583,17 +596,6 @@ namespace QuantLib {
                                 V_[j][stepToUse][i-1] += thisDerivative; // zeroth row of V is t =0 not t_0
                             }
 
-                            // ok we've got the derivatives and stored them, now add them to vegas
-                            // this corresponds to the \frac{\partial F_n}[\partial theta} term
-                            // we add the indirect terms later
-
-                            for (Size k=0; k < numberBumps_; ++k)
-                                for (Size i=0; i < numberRates_; ++i)
-                                {
-                                    vegasThisPath_[j][k] +=  fullDerivatives_[i]*jacobiansThisPaths_[stepToUse-1][k][i];
-                                }
-
-
                         } // end of (numberCashFlowsThisIndex_[j][cashFlowIndex] > 0)
                     } // end of (Size j=0; j < numberProducts_; ++j)
                 } // end of  if (!noFlows)
@@ -644,15 +646,6 @@ namespace QuantLib {
 
                         } //end of  for (Size j=0; j < numberRates_; ++j)
 
-                    // we've done the Vs now the vegas
-
-                        if (nextStepIndex >0)
-
-                            for (Size l=0; l < numberBumps_; ++l)
-                                for (Size j=0; j < numberRates_; ++j)
-                                    vegasThisPath_[i][l] +=  V_[i][nextStepIndex][j] * jacobiansThisPaths_[nextStepIndex-1][l][j];
-
-
                     } // end of (Size i=0; i < numberProducts_; ++i)
 
 
@@ -662,6 +655,39 @@ namespace QuantLib {
 
         } // end of  for (Integer currentStep =  numberSteps_-1; currentStep >=0 ; --currentStep)
 
+        // all V matrices computed we now compute the vegas for this path
+        // each bump of the pseudo-root at step j affects the evolution on that step only, so the vega is the sum over the steps
+        // of V after the step paired with the sensitivity of the rates to the bump; we push V back onto the pseudo-root elements
+        // first and only then combine with the bumps, rather than computing the effect of each bump on each rate
+
+        for (Size i=0; i < numberProducts_; ++i)
+        {
+            for (Size j=0; j < numberSteps_ && static_cast<Integer>(j) <= finalStepDone; ++j)
+            {
+                Size nextIndex = j+1;
+
+                for (Size r=0; r < numberRates_; ++r)
+                    rateAdjoints_[r] = V_[i][nextIndex][r];
+
+                jacobianComputers_[j].getAdjoints(forwardsThisPath_[j],
+                                                  stepsDiscountsThisPath_[j],
+                                                  forwardsThisPath_[nextIndex],
+                                                  gaussiansThisPath_[j],
+                                                  rateAdjoints_,
+                                                  pseudoRootAdjoints_);
+
+                for (Size l=0; l < numberBumps_; ++l)
+                {
+                    const Matrix& bump = vegaBumps_[j][l];
+                    Real sum = 0.0;
+                    for (Size k=0; k < numberRates_; ++k)
+                        for (Size f=0; f < factors_; ++f)
+                            sum += bump[k][f]*pseudoRootAdjoints_[k][f];
+                    vegasThisPath_[i][l] += sum;
+                }
+            }
+        }
+
         // write answer into values
 
         Size entriesPerProduct = 1+numberRates_+numberBumps_;
@@ -751,23 +777,19 @@ namespace QuantLib {
 
         numberBumps_ = vegaBumps[0].size();
 
-       std::vector<Matrix> jacobiansThisPathsModel;
-       for (Size i =0; i < numberRates_; ++i)
-              jacobiansThisPathsModel.push_back(Matrix(numberRates_,factors_));
-
-
-
         for (Size i =0; i < numberSteps_; ++i)
         {
               jacobianComputers_.push_back(RatePseudoRootJacobianAllElements(pseudoRootStructure_->pseudoRoot(i),evolution.firstAliveRate()[i],
                                 numeraires_[i],
                                 evolution.rateTaus(),
                                 pseudoRootStructure_->displacements()));
-
-              // vector of vector of matrices to store jacobians of rates with respect to pseudo-root elements
-            jacobiansThisPaths_.push_back(jacobiansThisPathsModel);
         }
 
+        forwardsThisPath_.resize(numberSteps_+1, std::vector<Real>(numberRates_));
+        stepsDiscountsThisPath_.resize(numberSteps_, std::vector<Real>(numberRates_+1));
+        gaussiansThisPath_.resize(numberSteps_, std::vector<Real>(factors_));
+        rateAdjoints_.resize(numberRates_);
+
 
 
         Matrix VModel(numberSteps_+1,numberRates_);
@@ -924,13 +946,11 @@ namespace QuantLib {
                 Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
             }
 
-            jacobianComputers_[thisStep].getBumps(lastForwards_,
-                                         stepsDiscounts_,
-                                         currentForwards_,
-                                         evolver_->browniansThisStep(),
-                                         jacobiansThisPaths_[thisStep]);
-
-//            gaussians_[thisStep] = evolver_->browniansThisStep();
+            // store what the adjoint sweep will need for this step
+            forwardsThisPath_[thisStep] = lastForwards_;
+            forwardsThisPath_[storeStep] = currentForwards_;
+            stepsDiscountsThisPath_[thisStep] = stepsDiscounts_;
+            gaussiansThisPath_[thisStep] = evolver_->browniansThisStep();
 
 
 
@@ -1065,34 +1085,33 @@ namespace QuantLib {
 
 
         // all V matrices computed we now compute the elementary vegas for this path 
+        // note the simplification here arising from the fact that the elementary vega affects the evolution on precisely one step,
+        // so that pairing V after the step with the sensitivity of the rates to the pseudo-root can be done backwards, one step at a time
 
         for (Size i=0; i < numberProducts_; ++i)
         {
                 for (Size j=0; j < numberSteps_; ++j)
                 {
-                    Size nextIndex = j+1;
-
-                    // we know V, we need to pair against the senstivity of the rate to the elementary vega
-                    // note the simplification here arising from the fact that the elementary vega affects the evolution on precisely one step
-
-                    for (Size k=0; k < numberRates_; ++k)
-                        for (Size f=0; f < factors_; ++f)
-                        {
-                                Real sensitivity =0.0;
-
-                                for (Size r=0; r < numberRates_; ++r)
-                                {
-                                        sensitivity += V_[i][nextIndex][r]*jacobiansThisPaths_[j][r][k][f];
+                    if (static_cast<Integer>(j) > finalStepDone)
+                    {
+                        // path ended before this step, so it cannot depend on its pseudo-root
+                        for (Size k=0; k < numberRates_; ++k)
+                            for (Size f=0; f < factors_; ++f)
+                                elementary_vegas_ThisPath_[i][j][k][f] = 0.0;
+                        continue;
+                    }
 
-                                  }
-/*
-                                  if (j ==distinguishedStep_ && k ==distinguishedRate_ &&f== distinguishedFactor_)
-                                      std::cout << sensitivity << "," <<  jacobiansThisPaths_[j][j][k][f] << "," << gaussians_[j][f] << "," << V_[i][nextIndex][j] << "," << LIBORRates_[nextIndex][j] << "\n";
-  */                
+                    Size nextIndex = j+1;
 
+                    for (Size r=0; r < numberRates_; ++r)
+                        rateAdjoints_[r] = V_[i][nextIndex][r];
 
-                                elementary_vegas_ThisPath_[i][j][k][f] = sensitivity;
-                        }
+                    jacobianComputers_[j].getAdjoints(forwardsThisPath_[j],
+                                                      stepsDiscountsThisPath_[j],
+                                                      forwardsThisPath_[nextIndex],
+                                                      gaussiansThisPath_[j],
+                                                      rateAdjoints_,
+                                                      elementary_vegas_ThisPath_[i][j]);
                 }
         }
 
@@ -108,7 +108,9 @@ namespace QuantLib {
     // To compute a vega means changing the pseudo-square root at each time step
     // So for each vega, we have a vector of matrices. So we need a vector of vectors of matrices to compute all the vegas.
     // We do the outermost vector by time step and inner one by which vega.
-    // This is tested in MarketModelTest::testPathwiseVegas
+    // The sensitivities to the pseudo-root elements are obtained in reverse mode, as in PathwiseVegasOuterAccountingEngine,
+    // and only then combined with the bumps of each step.
+    // This is tested in MarketModelTest::testPathwiseVegas and MarketModelTest::testPathwiseVegasAgainstBumps
 
     class PathwiseVegasAccountingEngine 
     {
@@ -136,8 +138,10 @@ namespace QuantLib {
         Size numberCashFlowTimes_;
         Size numberSteps_;
         Size numberBumps_;
+        Size factors_;
 
-        std::vector<RatePseudoRootJacobian> jacobianComputers_;
+        std::vector<std::vector<Matrix> > vegaBumps_;
+        std::vector<RatePseudoRootJacobianAllElements> jacobianComputers_;
 
         
         bool doDeflation_;
@@ -163,7 +167,13 @@ namespace QuantLib {
         Matrix partials_; // dimensions are factor and rate
 
         Matrix vegasThisPath_; // dimensions are product and which vega
-        std::vector<Matrix> jacobiansThisPaths_; // dimensions are step, rate and factor
+
+        // path data needed by the adjoint sweep, one entry for each step
+        std::vector<std::vector<Real> > forwardsThisPath_;        // forwards at each evolution time, goes from 0 to number of steps
+        std::vector<std::vector<Real> > stepsDiscountsThisPath_;  // one-step discount ratios after the step
+        std::vector<std::vector<Real> > gaussiansThisPath_;
+        std::vector<Real> rateAdjoints_;
+        Matrix pseudoRootAdjoints_; // dimensions are rate and factor
 
         std::vector<Real> deflatorAndDerivatives_;
         std::vector<Real> fullDerivatives_;
@@ -187,6 +197,9 @@ namespace QuantLib {
     // We do the outermost vector by time step and inner one by which vega.
     // This implementation is different in that all the linear combinations by the bumps are done as late as possible,
     // whereas PathwiseVegasAccountingEngine does them as early as possible. 
+    // The sensitivities to the pseudo-root elements are obtained in reverse mode: the rate adjoints V of each step
+    // are pushed back through the Euler step onto its pseudo-root, so the work per path is a constant multiple
+    // of the pricing itself, whatever the number of rates, factors and bumps.
     // This is tested in MarketModelTest::testPathwiseVegas
 
     class PathwiseVegasOuterAccountingEngine 
@@ -252,7 +265,12 @@ namespace QuantLib {
         Matrix partials_; // dimensions are factor and rate
 
         std::vector<std::vector<Matrix>   > elementary_vegas_ThisPath_;  // dimensions are product, step,  rate and factor
-        std::vector<std::vector<Matrix> > jacobiansThisPaths_;                      // dimensions are step, rate, rate and factor
+
+        // path data needed by the adjoint sweep, one entry for each step
+        std::vector<std::vector<Real> > forwardsThisPath_;        // forwards at each evolution time, goes from 0 to number of steps
+        std::vector<std::vector<Real> > stepsDiscountsThisPath_;  // one-step discount ratios after the step
+        std::vector<std::vector<Real> > gaussiansThisPath_;
+        std::vector<Real> rateAdjoints_;
 
         std::vector<Real> deflatorAndDerivatives_;
         std::vector<Real> fullDerivatives_;
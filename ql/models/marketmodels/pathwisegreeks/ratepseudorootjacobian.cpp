@@ -21,6 +21,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 
 #include <ql/models/marketmodels/pathwisegreeks/ratepseudorootjacobian.hpp>
+#include <algorithm>
 
 namespace QuantLib
 {
@@ -255,7 +256,8 @@ namespace QuantLib
         factors_(pseudoRoot.columns()),
      //   bumpedRates_(taus.size()),
         e_(pseudoRoot.rows(), pseudoRoot.columns()),
-        ratios_(taus_.size())
+        ratios_(taus_.size()),
+        suffixSums_(pseudoRoot.columns())
     {
         Size numberRates= taus.size();
 
@@ -330,9 +332,61 @@ namespace QuantLib
             }
     }
 
-    
-}
+    void RatePseudoRootJacobianAllElements::getAdjoints(const std::vector<Rate>& oldRates,
+        const std::vector<Real>& discountRatios,
+        const std::vector<Rate>& newRates,
+        const std::vector<Real>& gaussians,
+        const std::vector<Real>& rateAdjoints,
+        Matrix& pseudoRootAdjoints)
+    {
+        Size numberRates = taus_.size();
 
+        QL_REQUIRE(rateAdjoints.size() == numberRates, "we need rateAdjoints.size() which is " << rateAdjoints.size() << " to equal numberRates which is "  << numberRates);
+        QL_REQUIRE(pseudoRootAdjoints.rows() == numberRates && pseudoRootAdjoints.columns() == factors_,
+                   "we need pseudoRootAdjoints.rows() which is " << pseudoRootAdjoints.rows() << " to equal numberRates which is "  << numberRates <<
+                   " and pseudoRootAdjoints.columns() which is " << pseudoRootAdjoints.columns() << " to be equal to factors which is " << factors_);
 
+        for (Size j=aliveIndex_; j < numberRates; ++j)
+            ratios_[j] = (oldRates[j] + displacements_[j])*discountRatios[j+1];
+
+        for (Size f=0; f < factors_; ++f)
+        {
+            e_[aliveIndex_][f] = 0;
+
+            for (Size j= aliveIndex_+1; j < numberRates; ++j)
+                e_[j][f] = e_[j-1][f] + ratios_[j-1]*pseudoRoot_[j-1][f];
+        }
 
+        // rates that have already reset are not affected
+        for (Size k=0; k < aliveIndex_; ++k)
+            for (Size f=0; f < factors_; ++f)
+                pseudoRootAdjoints[k][f] = 0.0;
 
+        // Row k of the pseudo-root enters the diagonal term of rate k and,
+        // through the drift, every later rate j > k. The latter contributions
+        // share the factor ratios_[k]*taus_[k], so summing rates from the back
+        // gives all of them in one sweep, i.e. sum_j V_j B[j][k][f] as in getBumps
+        std::fill(suffixSums_.begin(), suffixSums_.end(), 0.0);
+
+        for (Size k=numberRates; k > aliveIndex_; --k)
+        {
+            Size j = k-1;
+            Real V = rateAdjoints[j];
+            Real scale = ratios_[j]*taus_[j];
+
+            for (Size f=0; f < factors_; ++f)
+            {
+                Real tmp = 2*ratios_[j]*taus_[j]*pseudoRoot_[j][f];
+                tmp -=  pseudoRoot_[j][f];
+                tmp += e_[j][f]*taus_[j];
+                tmp += gaussians[f];
+                tmp *= (newRates[j]+displacements_[j]);
+
+                pseudoRootAdjoints[j][f] = V*tmp + scale*suffixSums_[f];
+
+                suffixSums_[f] += V*newRates[j]*pseudoRoot_[j][f];
+            }
+        }
+    }
+
+}
@@ -129,6 +129,19 @@ namespace QuantLib
             const std::vector<Real>& gaussians,
             std::vector<Matrix>& B); // one Matrix for each rate, the elements of the matrix are the derivatives of that rate with respect to each pseudo-root element
 
+        /*! reverse-mode version of getBumps: rather than the full
+            rates x rates x factors Jacobian, it returns its contraction
+            against the adjoints of the new rates, i.e. the derivatives
+            of the path value with respect to each pseudo-root element.
+            The cost is proportional to rates times factors.
+        */
+        void getAdjoints(const std::vector<Rate>& oldRates,
+            const std::vector<Real>& oneStepDFs,
+            const std::vector<Rate>& newRates,
+            const std::vector<Real>& gaussians,
+            const std::vector<Real>& rateAdjoints, // derivative of the path value with respect to each new rate
+            Matrix& pseudoRootAdjoints); // rows are rates, columns are factors
+
     private:
 
         //! this data does not change after construction
@@ -143,6 +156,7 @@ namespace QuantLib
 
         Matrix e_;
         std::vector<Real> ratios_;
+        std::vector<Real> suffixSums_;
    
     };
 
@@ -23,6 +23,8 @@
 #include <ql/math/optimization/projection.hpp>
 #include <ql/math/optimization/projectedconstraint.hpp>
 #include <ql/utilities/null_deleter.hpp>
+#include <ql/pricingengine.hpp>
+#include <algorithm>
 
 using std::vector;
 
@@ -31,7 +33,8 @@ namespace QuantLib {
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None),
+      parallelCalibration_(false) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
@@ -40,39 +43,135 @@ namespace QuantLib {
                             const vector<Real>& weights,
                             const Projection& projection)
             : model_(model, null_deleter()), instruments_(h),
-              weights_(weights), projection_(projection) {}
+              weights_(weights), projection_(projection),
+              firstEvaluation_(true) {
+            if (model->allowsParallelCalibration())
+                groups_ = CalibratedModel::calibrationGroups(h);
+        }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
-            model_->setParams(projection_.include(params));
+            Array errors = calibrationErrors(params);
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
             return std::sqrt(value);
         }
 
         virtual Disposable<Array> values(const Array& params) const {
-            model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
+            Array values = calibrationErrors(params);
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] *= std::sqrt(weights_[i]);
             }
             return values;
         }
 
+        // analytic when all the helpers provide the gradient of their
+        // error, by finite differences otherwise
+        virtual void jacobian(Matrix& jac, const Array& params) const {
+            const Array p = projection_.include(params);
+            model_->setParams(p);
+            for (Size i=0; i<instruments_.size(); i++) {
+                BlackCalibrationHelper* h =
+                    dynamic_cast<BlackCalibrationHelper*>(
+                                                    instruments_[i].get());
+                const Array gradient =
+                    h != 0 ? h->calibrationErrorGradient() : Array();
+                if (gradient.size() != p.size()) {
+                    CostFunction::jacobian(jac, params);
+                    return;
+                }
+                const Array g = projection_.project(gradient);
+                for (Size j=0; j<g.size(); j++)
+                    jac[i][j] = g[j]*std::sqrt(weights_[i]);
+            }
+        }
+
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        Disposable<Array> calibrationErrors(const Array& params) const {
+            model_->setParams(projection_.include(params));
+            Array errors(instruments_.size());
+            if (groups_.size() <= 1 || firstEvaluation_) {
+                for (Size i=0; i<instruments_.size(); i++)
+                    errors[i] = instruments_[i]->calibrationError();
+                firstEvaluation_ = false;
+                return errors;
+            }
+
+            // exceptions can't cross the boundary of the parallel
+            // region; the one from the first failing group is rethrown
+            vector<std::string> failures(groups_.size());
+            #pragma omp parallel for schedule(dynamic)
+            for (long g=0; g<(long)groups_.size(); ++g) {
+                try {
+                    const vector<Size>& group = groups_[g];
+                    for (Size j=0; j<group.size(); ++j)
+                        errors[group[j]] =
+                            instruments_[group[j]]->calibrationError();
+                } catch (std::exception& e) {
+                    failures[g] = e.what();
+                    if (failures[g].empty())
+                        failures[g] = "unknown error";
+                } catch (...) {
+                    failures[g] = "unknown error";
+                }
+            }
+            for (Size g=0; g<failures.size(); ++g)
+                QL_REQUIRE(failures[g].empty(), failures[g]);
+            return errors;
+        }
+
         ext::shared_ptr<CalibratedModel> model_;
         const vector<ext::shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        vector<vector<Size> > groups_;
+        mutable bool firstEvaluation_;
     };
 
+    // helpers sharing an engine (or whose engine is not known) are
+    // put in the same group, in order of appearance
+    vector<vector<Size> > CalibratedModel::calibrationGroups(
+                 const vector<ext::shared_ptr<CalibrationHelper> >& helpers) {
+        vector<const PricingEngine*> engines;
+        vector<vector<Size> > groups;
+        #if !defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        // implied-volatility errors need Black prices, which might
+        // register new observers with shared observables
+        for (Size i=0; i<helpers.size(); i++) {
+            const BlackCalibrationHelper* h =
+                dynamic_cast<const BlackCalibrationHelper*>(helpers[i].get());
+            if (h != 0 && h->calibrationErrorType() ==
+                                BlackCalibrationHelper::ImpliedVolError
+                       && !h->concurrentBlackPrices()) {
+                groups.push_back(vector<Size>(helpers.size()));
+                for (Size j=0; j<helpers.size(); j++)
+                    groups[0][j] = j;
+                return groups;
+            }
+        }
+        #endif
+        for (Size i=0; i<helpers.size(); i++) {
+            const BlackCalibrationHelper* h =
+                dynamic_cast<const BlackCalibrationHelper*>(helpers[i].get());
+            const PricingEngine* engine =
+                h != 0 ? h->pricingEngine().get() : 0;
+            Size g = std::find(engines.begin(), engines.end(), engine)
+                   - engines.begin();
+            if (g == engines.size()) {
+                engines.push_back(engine);
+                groups.push_back(vector<Size>());
+            }
+            groups[g].push_back(i);
+        }
+        return groups;
+    }
+
     void CalibratedModel::calibrate(
                     const vector<ext::shared_ptr<BlackCalibrationHelper> >& instruments,
                     OptimizationMethod& method,
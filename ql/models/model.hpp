@@ -140,6 +140,58 @@ namespace QuantLib {
         virtual void setParams(const Array& params);
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        //! \name Parallel calibration
+        /*! When enabled, and if the library was compiled with
+            OpenMP support, the calibration helpers are priced
+            concurrently during calibration.  Helpers sharing the
+            same pricing engine are priced sequentially by the same
+            thread; therefore, helpers should be given separate engine
+            instances in order to take advantage of parallelism.
+            Helpers that are not Black calibration helpers are
+            treated as sharing the same engine.
+
+            The first evaluation is sequential, so that lazy market
+            data shared among helpers (e.g., bootstrapped curves) is
+            calculated before any concurrent access; calendars can be
+            queried concurrently.  Results don't depend on the number
+            of threads, nor on whether OpenMP is enabled.
+
+            \warning Besides engines, helpers and models are assumed
+                     not to be modified when priced; this is not the
+                     case for models with lazy caches, such as
+                     Gaussian1dModel, for which parallel calibration
+                     should not be enabled.  Also, unless the library
+                     was compiled with
+                     QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN, pricing
+                     must not register observers with observables
+                     shared among helpers (e.g., the discount curve),
+                     since registration is not thread-safe.  Black
+                     prices of caps and swaptions do, by building
+                     engines; therefore, helpers not declaring
+                     concurrent Black prices are calibrated
+                     sequentially when they use implied volatility
+                     errors.  Engines and helpers creating observers
+                     in other circumstances are not supported.
+        */
+        //@{
+        void enableParallelCalibration(bool b = true) {
+            parallelCalibration_ = b;
+        }
+        void disableParallelCalibration() { parallelCalibration_ = false; }
+        bool allowsParallelCalibration() const {
+            return parallelCalibration_;
+        }
+        //! groups of helpers priced by the same thread
+        /*! Each group contains the indices of the helpers sharing a
+            pricing engine, in order of appearance.  Without the
+            thread-safe observer pattern, a single group is returned
+            if any helper uses implied volatility errors without
+            allowing concurrent Black prices.
+        */
+        static std::vector<std::vector<Size> > calibrationGroups(
+             const std::vector<ext::shared_ptr<CalibrationHelper> >& helpers);
+        //@}
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -149,6 +201,7 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        bool parallelCalibration_;
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
@@ -282,4 +282,64 @@ const Disposable<Array> Gaussian1dModel::yGrid(const Real stdDevs,
 
     return result;
 }
+
+void Gaussian1dModel::enableStateGridCaching(bool enable) {
+    stateGridCaching_ = enable;
+    flushStateGridCache();
+}
+
+// the engines call the model from within their parallelized loops,
+// so access to the caches is serialized by a lock of the model while
+// the values themselves are computed without holding it
+
+Real Gaussian1dModel::cachedNumeraire(const Time t, const Real y) const {
+
+    StateGridKey k = {t, t, y};
+    bool found = false;
+    Real value = 0.0;
+    {
+#ifdef _OPENMP
+        boost::mutex::scoped_lock lock(stateGridCacheMutex_);
+#endif
+        StateGridCacheType::const_iterator i = numeraireCache_.find(k);
+        if (i != numeraireCache_.end()) {
+            value = i->second;
+            found = true;
+        }
+    }
+    if (!found) {
+        value = numeraireImpl(t, y, Handle<YieldTermStructure>());
+#ifdef _OPENMP
+        boost::mutex::scoped_lock lock(stateGridCacheMutex_);
+#endif
+        numeraireCache_.insert(std::make_pair(k, value));
+    }
+    return value;
+}
+
+Real Gaussian1dModel::cachedZerobond(const Time T, const Time t,
+                                     const Real y) const {
+
+    StateGridKey k = {T, t, y};
+    bool found = false;
+    Real value = 0.0;
+    {
+#ifdef _OPENMP
+        boost::mutex::scoped_lock lock(stateGridCacheMutex_);
+#endif
+        StateGridCacheType::const_iterator i = zerobondCache_.find(k);
+        if (i != zerobondCache_.end()) {
+            value = i->second;
+            found = true;
+        }
+    }
+    if (!found) {
+        value = zerobondImpl(T, t, y, Handle<YieldTermStructure>());
+#ifdef _OPENMP
+        boost::mutex::scoped_lock lock(stateGridCacheMutex_);
+#endif
+        zerobondCache_.insert(std::make_pair(k, value));
+    }
+    return value;
+}
 }
@@ -50,6 +50,9 @@
 #endif
 #include <boost/math/special_functions/erf.hpp>
 #include <boost/unordered_map.hpp>
+#ifdef _OPENMP
+#include <boost/thread/mutex.hpp>
+#endif
 #if defined(__GNUC__) &&                                                       \
     (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
@@ -71,6 +74,14 @@ namespace QuantLib {
     \warning the variance of the state process conditional on
     $x(t)=x$ must be independent of the value of $x$
 
+    Zerobond and numeraire values on the model's own curve can be
+    cached by calling enableStateGridCaching(). The integration
+    engines evaluate them on the same state grids for every
+    instrument, so all engines sharing the model are then served
+    from a single cache fill. The cache is flushed whenever the
+    model is updated or its parameters are changed, e.g. during
+    calibration.
+
 */
 
 class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
@@ -148,7 +159,47 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
                                   const Real T = 1.0, const Real t = 0,
                                   const Real y = 0) const;
 
+    /*! Enables (or disables) the caching of zerobond and numeraire
+        values computed on the model's own curve, i.e. for calls
+        without an explicit yield term structure. The cache is
+        keyed on the exact time and state arguments, so it grows
+        with the number of distinct grid points requested; it is
+        meant for the integration grids used by the pricing
+        engines, not for e.g. Monte Carlo paths. */
+    void enableStateGridCaching(bool enable = true);
+    bool stateGridCaching() const { return stateGridCaching_; }
+
   private:
+    struct StateGridKey {
+        Time T, t;
+        Real y;
+        bool operator==(const StateGridKey &o) const {
+            return T == o.T && t == o.t && y == o.y;
+        }
+    };
+
+    struct StateGridKeyHasher {
+        std::size_t operator()(StateGridKey const &x) const {
+            std::size_t seed = 0;
+            boost::hash_combine(seed, x.T);
+            boost::hash_combine(seed, x.t);
+            boost::hash_combine(seed, x.y);
+            return seed;
+        }
+    };
+
+    typedef boost::unordered_map<StateGridKey, Real, StateGridKeyHasher>
+        StateGridCacheType;
+
+    Real cachedNumeraire(const Time t, const Real y) const;
+    Real cachedZerobond(const Time T, const Time t, const Real y) const;
+
+    bool stateGridCaching_;
+    mutable StateGridCacheType numeraireCache_, zerobondCache_;
+#ifdef _OPENMP
+    mutable boost::mutex stateGridCacheMutex_;
+#endif
+
     // It is of great importance for performance reasons to cache underlying
     // swaps generated from indexes. In addition the indexes may only be given
     // as templates for the conventions with the tenor replaced by the actual
@@ -183,7 +234,8 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
   protected:
     // we let derived classes register with the termstructure
     Gaussian1dModel(const Handle<YieldTermStructure> &yieldTermStructure)
-        : TermStructureConsistentModel(yieldTermStructure) {
+        : TermStructureConsistentModel(yieldTermStructure),
+          stateGridCaching_(false) {
         registerWith(Settings::instance().evaluationDate());
     }
 
@@ -203,10 +255,18 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
     }
 
     void generateArguments() {
+        flushStateGridCache();
         calculate();
         notifyObservers();
     }
 
+    // must be called by derived classes whenever the values
+    // returned by numeraireImpl or zerobondImpl may have changed
+    void flushStateGridCache() const {
+        numeraireCache_.clear();
+        zerobondCache_.clear();
+    }
+
     // retrieve underlying swap from cache if possible, otherwise
     // create it and store it in the cache
     ext::shared_ptr<VanillaSwap>
@@ -240,12 +300,16 @@ inline Real
 Gaussian1dModel::numeraire(const Time t, const Real y,
                            const Handle<YieldTermStructure> &yts) const {
 
+    if (stateGridCaching_ && yts.empty())
+        return cachedNumeraire(t, y);
     return numeraireImpl(t, y, yts);
 }
 
 inline Real
 Gaussian1dModel::zerobond(const Time T, const Time t, const Real y,
                           const Handle<YieldTermStructure> &yts) const {
+    if (stateGridCaching_ && yts.empty())
+        return cachedZerobond(T, t, y);
     return zerobondImpl(T, t, y, yts);
 }
 
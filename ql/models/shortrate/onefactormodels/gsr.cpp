@@ -94,6 +94,7 @@ Gsr::Gsr(const Handle<YieldTermStructure> &termStructure,
 void Gsr::update() { 
 	if (stateProcess_ != NULL)
         ext::static_pointer_cast<GsrProcess>(stateProcess_)->flushCache();
+    flushStateGridCache();
 	LazyObject::update();
 }
 
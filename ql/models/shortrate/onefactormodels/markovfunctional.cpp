@@ -391,10 +391,7 @@ namespace QuantLib {
                         "for sabr calibration at least 4 points are needed (is "
                             << k.size() << ")");
                     std::vector<Real> v;
-                    for (Size j = 0; j < k.size(); j++) {
-                        v.push_back(
-                            i->second.rawSmileSection_->volatility(k[j]));
-                    }
+                    i->second.rawSmileSection_->volatilities(k, v);
 
                     // TODO should we fix beta to avoid numerical instabilities
                     // during calibration ?
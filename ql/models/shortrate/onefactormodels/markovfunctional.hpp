@@ -371,6 +371,7 @@ namespace QuantLib {
         #endif
 
         void update() {
+            flushStateGridCache();
             LazyObject::update();
         }
 
@@ -401,6 +402,7 @@ namespace QuantLib {
             // hard to avoid though.
             calculate();
             updateNumeraireTabulation();
+            flushStateGridCache();
             notifyObservers();
         }
 
@@ -33,6 +33,7 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <algorithm>
 
 
 #if defined(QL_PATCH_MSVC)
@@ -120,6 +121,83 @@ namespace QuantLib {
             const Real v0T2_, logEpsilon_;
             mutable Size evaluations_;
         };
+
+        // derivatives of the Gatheral integrand of Fj_Helper with
+        // respect to theta, kappa, sigma, rho and v0
+        class Fj_GradientHelper {
+          public:
+            Fj_GradientHelper(Real kappa, Real theta, Real sigma,
+                              Real v0, Real s0, Real rho,
+                              Time term, Real strike, Real ratio, Size j)
+            : j_(j), kappa_(kappa), theta_(theta), sigma_(sigma),
+              v0_(v0), rho_(rho), term_(term),
+              x_(std::log(s0)), sx_(std::log(strike)),
+              dd_(x_-std::log(ratio)),
+              sigma2_(sigma_*sigma_), rsigma_(rho_*sigma_),
+              t0_(kappa - ((j== 1)? rho*sigma : 0)) {}
+
+            void operator()(Real phi, Array& f) const {
+                typedef std::complex<Real> complex;
+
+                const Real rpsig(rsigma_*phi);
+                const Real s = (j_== 1)? 1 : -1, j1 = (j_== 1)? 1 : 0;
+
+                const complex t1 = t0_+complex(0, -rpsig);
+                const complex c = phi*complex(-phi, s);
+                const complex d = std::sqrt(t1*t1 - sigma2_*c);
+                const complex ex = std::exp(-d*term_);
+                const complex p = (t1-d)/(t1+d);
+                const complex g = std::log((1.0 - p*ex)/(1.0 - p));
+
+                const complex a = (t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p));
+                const complex l = (t1-d)*term_-2.0*g;
+                const complex e = std::exp(v0_*a
+                                          + (kappa_*theta_)/sigma2_*l
+                                          + complex(0.0, phi*(dd_-sx_)));
+
+                // the exponent depends on kappa, sigma and rho through
+                // t1 (and on sigma directly); dt1[k] and dSigma[k] are
+                // their derivatives with respect to each parameter
+                const complex dt1[3] = {
+                    complex(1.0),
+                    complex(-rho_*j1, -rho_*phi),
+                    complex(-sigma_*j1, -sigma_*phi)
+                };
+                const Real dSigma[3] = { 0.0, 1.0, 0.0 };
+                const Real dKappa[3] = { 1.0, 0.0, 0.0 };
+
+                f[0] = (e*(kappa_/sigma2_)*l).imag()/phi;
+                for (Size k=0; k<3; ++k) {
+                    const complex dd = (t1*dt1[k] - sigma_*dSigma[k]*c)/d;
+                    const complex dex = -term_*ex*dd;
+                    const complex dp =
+                        2.0*(d*dt1[k] - t1*dd)/((t1+d)*(t1+d));
+                    const complex dg = dp/(1.0-p)
+                                     - (dp*ex + p*dex)/(1.0-p*ex);
+                    const complex dn =
+                        (dt1[k]-dd)*(1.0-ex) - (t1-d)*dex;
+                    const complex dm = -(dex*p + ex*dp);
+                    const complex da =
+                        (dn - a*sigma2_*dm)/(sigma2_*(1.0-ex*p))
+                        - 2.0*dSigma[k]*a/sigma_;
+                    const complex dl = (dt1[k]-dd)*term_ - 2.0*dg;
+                    const complex db =
+                        (dKappa[k]*theta_/sigma2_
+                         - 2.0*dSigma[k]*kappa_*theta_/(sigma2_*sigma_))*l
+                        + (kappa_*theta_)/sigma2_*dl;
+                    f[k+1] = (e*(v0_*da + db)).imag()/phi;
+                }
+                f[4] = (e*a).imag()/phi;
+            }
+
+          private:
+            const Size j_;
+            const Real kappa_, theta_, sigma_, v0_, rho_;
+            const Time term_;
+            const Real x_, sx_, dd_;
+            const Real sigma2_, rsigma_;
+            const Real t0_;
+        };
     }
 
     // helper class for integration
@@ -404,6 +482,77 @@ namespace QuantLib {
         const AnalyticHestonEngine* const enginePtr_;
     };
 
+    // Gatheral integrands of Fj_Helper for several strikes at once;
+    // the strike only enters through the phase of the integrand
+    class AnalyticHestonEngine::Fj_MultiStrikeHelper {
+      public:
+        Fj_MultiStrikeHelper(Real kappa, Real theta, Real sigma,
+                             Real v0, Real s0, Real rho,
+                             const AnalyticHestonEngine* const engine,
+                             Time term,
+                             const std::vector<Real>& strikes,
+                             Real ratio,
+                             Size j)
+        : j_(j), kappa_(kappa), theta_(theta), sigma_(sigma), v0_(v0),
+          term_(term), x_(std::log(s0)), sx_(strikes.size()),
+          dd_(x_-std::log(ratio)),
+          sigma2_(sigma_*sigma_), rsigma_(rho*sigma_),
+          t0_(kappa - ((j== 1)? rho*sigma : 0)),
+          engine_(engine) {
+            for (Size i=0; i < strikes.size(); ++i)
+                sx_[i] = std::log(strikes[i]);
+        }
+
+        void operator()(Real phi, Array& f) const {
+            const Real rpsig(rsigma_*phi);
+
+            const std::complex<Real> t1 = t0_+std::complex<Real>(0, -rpsig);
+            const std::complex<Real> d =
+                std::sqrt(t1*t1 - sigma2_*phi
+                          *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
+            const std::complex<Real> ex = std::exp(-d*term_);
+            const std::complex<Real> addOnTerm
+                = engine_->addOnTerm(phi, term_, j_);
+
+            std::complex<Real> e;
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                e = std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                             + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                             + addOnTerm);
+            }
+            else {
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                e = std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
+                             + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                             + addOnTerm);
+            }
+
+            for (Size i=0; i < sx_.size(); ++i) {
+                const Real a = phi*(dd_-sx_[i]);
+                f[i] = (e.real()*std::sin(a) + e.imag()*std::cos(a))/phi;
+            }
+        }
+
+      private:
+        const Size j_;
+        const Real kappa_, theta_, sigma_, v0_;
+        const Time term_;
+        const Real x_;
+        std::vector<Real> sx_;
+        const Real dd_;
+        const Real sigma2_, rsigma_;
+        const Real t0_;
+        const AnalyticHestonEngine* const engine_;
+    };
+
     std::complex<Real> AnalyticHestonEngine::lnChF(
         const std::complex<Real>& z, Time t) const {
 
@@ -602,6 +751,32 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
+        if (!strikes_.empty()) {
+            const Date maturityDate = arguments_.exercise->lastDate();
+            const std::pair<Date, Real> key(maturityDate, strikePrice);
+            if (cachedValues_.find(key) == cachedValues_.end()) {
+                std::vector<Real> strikes(strikes_);
+                if (std::find(strikes.begin(), strikes.end(), strikePrice)
+                                                            == strikes.end())
+                    strikes.push_back(strikePrice);
+                calculateMultipleStrikes(riskFreeDiscount, dividendDiscount,
+                                         spotPrice, strikes, term,
+                                         maturityDate);
+            }
+            const std::pair<Real, Real>& values = cachedValues_[key];
+            switch (payoff->optionType()) {
+              case Option::Call:
+                results_.value = values.first;
+                break;
+              case Option::Put:
+                results_.value = values.second;
+                break;
+              default:
+                QL_FAIL("unknown option type");
+            }
+            return;
+        }
+
         doCalculation(riskFreeDiscount,
                       dividendDiscount,
                       spotPrice,
@@ -621,6 +796,136 @@ namespace QuantLib {
     }
 
 
+    void AnalyticHestonEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedValues_.clear();
+    }
+
+    void AnalyticHestonEngine::update() {
+        cachedValues_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    void AnalyticHestonEngine::calculateMultipleStrikes(
+                                        Real riskFreeDiscount,
+                                        Real dividendDiscount,
+                                        Real spotPrice,
+                                        const std::vector<Real>& strikes,
+                                        Time term,
+                                        const Date& maturityDate) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        // the put values follow from the put-call parity
+        const Real fwdValue = spotPrice*dividendDiscount;
+        std::vector<Real> calls(strikes.size());
+
+        if (cpxLog_ == Gatheral && integration_->isGaussianQuadrature()) {
+            const Real ratio = riskFreeDiscount/dividendDiscount;
+            const Real c_inf = std::min(0.2, std::max(0.0001,
+                std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+
+            const Array p1 = integration_->calculateAll(c_inf,
+                Fj_MultiStrikeHelper(kappa, theta, sigma, v0, spotPrice, rho,
+                                     this, term, strikes, ratio, 1),
+                strikes.size())/M_PI;
+            const Array p2 = integration_->calculateAll(c_inf,
+                Fj_MultiStrikeHelper(kappa, theta, sigma, v0, spotPrice, rho,
+                                     this, term, strikes, ratio, 2),
+                strikes.size())/M_PI;
+            evaluations_ = 2*integration_->numberOfEvaluations();
+
+            for (Size i=0; i < strikes.size(); ++i)
+                calls[i] = fwdValue*(p1[i]+0.5)
+                         - strikes[i]*riskFreeDiscount*(p2[i]+0.5);
+        }
+        else {
+            evaluations_ = 0;
+            for (Size i=0; i < strikes.size(); ++i) {
+                Size evaluations;
+                doCalculation(riskFreeDiscount, dividendDiscount, spotPrice,
+                              strikes[i], term,
+                              kappa, theta, sigma, v0, rho,
+                              PlainVanillaPayoff(Option::Call, strikes[i]),
+                              *integration_, cpxLog_, this,
+                              calls[i], evaluations);
+                evaluations_ += evaluations;
+            }
+        }
+
+        for (Size i=0; i < strikes.size(); ++i)
+            cachedValues_[std::make_pair(maturityDate, strikes[i])] =
+                std::make_pair(calls[i],
+                               calls[i] - fwdValue
+                                        + strikes[i]*riskFreeDiscount);
+    }
+
+    bool AnalyticHestonEngine::providesValueGradient() const {
+        return cpxLog_ == Gatheral
+            && integration_->isGaussianQuadrature()
+            && model_->params().size() == 5
+            && addOnTerm(1.0, 1.0, 1) == std::complex<Real>(0.0)
+            && addOnTerm(1.0, 1.0, 2) == std::complex<Real>(0.0)
+            && model_->sigma() > 1e-5;
+    }
+
+    Disposable<Array> AnalyticHestonEngine::valueGradient(
+                        const VanillaOption::arguments& arguments) const {
+        QL_REQUIRE(providesValueGradient(),
+                   "value gradient requires the plain Heston model, "
+                   "Gatheral's complex log formula and a non-adaptive "
+                   "Gaussian quadrature");
+        QL_REQUIRE(arguments.exercise->type() == Exercise::European,
+                   "not an European option");
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount = process->riskFreeRate()->discount(
+                                            arguments.exercise->lastDate());
+        const Real dividendDiscount = process->dividendYield()->discount(
+                                            arguments.exercise->lastDate());
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real strikePrice = payoff->strike();
+        const Real term = process->time(arguments.exercise->lastDate());
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        const Real c_inf = std::min(0.2, std::max(0.0001,
+            std::sqrt(1.0-rho*rho)/sigma))*(v0 + kappa*theta*term);
+
+        const Array dp1 = integration_->calculateAll(c_inf,
+            Fj_GradientHelper(kappa, theta, sigma, v0, spotPrice, rho,
+                              term, strikePrice, ratio, 1), 5);
+        const Array dp2 = integration_->calculateAll(c_inf,
+            Fj_GradientHelper(kappa, theta, sigma, v0, spotPrice, rho,
+                              term, strikePrice, ratio, 2), 5);
+
+        // the option type only changes a constant term of the value
+        Array gradient(5);
+        for (Size i=0; i<5; ++i)
+            gradient[i] = (spotPrice*dividendDiscount*dp1[i]
+                           - strikePrice*riskFreeDiscount*dp2[i])/M_PI;
+        return gradient;
+    }
+
+
     AnalyticHestonEngine::Integration::Integration(
             Algorithm intAlgo,
             const ext::shared_ptr<Integrator>& integrator)
@@ -734,6 +1039,42 @@ namespace QuantLib {
             || intAlgo_ == Trapezoid;
     }
 
+    bool AnalyticHestonEngine::Integration::isGaussianQuadrature() const {
+        return intAlgo_ == GaussLaguerre
+            || intAlgo_ == GaussLegendre
+            || intAlgo_ == GaussChebyshev
+            || intAlgo_ == GaussChebyshev2nd;
+    }
+
+    Disposable<Array> AnalyticHestonEngine::Integration::calculateAll(
+                               Real c_inf,
+                               const ext::function<void(Real, Array&)>& f,
+                               Size n) const {
+        QL_REQUIRE(isGaussianQuadrature(),
+                   "only non-adaptive Gaussian quadratures can "
+                   "integrate several functions at once");
+
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+
+        // same nodes, mapping and summation order as calculate()
+        Array retVal(n, 0.0), fx(n);
+        for (Integer i = gaussianQuadrature_->order()-1; i >= 0; --i) {
+            Real phi = x[i], scale = 1.0;
+            if (intAlgo_ != GaussLaguerre) {
+                scale = (1.0-x[i])*c_inf;
+                if (scale <= QL_EPSILON)
+                    continue;
+                phi = -std::log(0.5-0.5*x[i])/c_inf;
+            }
+            f(phi, fx);
+            for (Size k=0; k<n; ++k)
+                retVal[k] += w[i]*(fx[k]/scale);
+        }
+
+        return retVal;
+    }
+
     Real AnalyticHestonEngine::Integration::calculate(
                                Real c_inf,
                                const ext::function<Real(Real)>& f,
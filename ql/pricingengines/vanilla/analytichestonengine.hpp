@@ -33,6 +33,7 @@
 #include <ql/instruments/vanillaoption.hpp>
 #include <ql/functional.hpp>
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -122,6 +123,39 @@ namespace QuantLib {
         void calculate() const;
         Size numberOfEvaluations() const;
 
+        //! gradient of the option value with respect to the model parameters
+        /*! The derivatives are returned in the order of the model
+            parameters, i.e., with respect to theta, kappa, sigma, rho
+            and v0.  The derivatives of the characteristic function
+            are calculated analytically and integrated on the same
+            quadrature nodes used for the value.
+
+            \warning The gradient is only available for the plain
+                     Heston model together with Gatheral's complex log
+                     formula and a non-adaptive Gaussian quadrature;
+                     see providesValueGradient().
+        */
+        Disposable<Array> valueGradient(
+                               const VanillaOption::arguments& arguments) const;
+        //! whether valueGradient() can be used with the current settings
+        bool providesValueGradient() const;
+
+        //! prices the given strikes together with the requested one
+        /*! When the engine is asked for the value of an option, it
+            also calculates the values of calls and puts on the given
+            strikes with the same expiry and caches them until the
+            model changes.  With Gatheral's complex log formula and a
+            non-adaptive Gaussian quadrature, the characteristic
+            function is evaluated once per quadrature node for all
+            the strikes, so that pricing a whole slice of strikes
+            costs about as much as pricing a single option.  With
+            other settings the strikes are priced one by one and only
+            the caching is used.
+        */
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
+        void update();
+
         static void doCalculation(Real riskFreeDiscount,
                                   Real dividendDiscount,
                                   Real spotPrice,
@@ -144,12 +178,25 @@ namespace QuantLib {
 
       private:
         class Fj_Helper;
+        class Fj_MultiStrikeHelper;
         class AP_Helper;
 
+        void calculateMultipleStrikes(Real riskFreeDiscount,
+                                      Real dividendDiscount,
+                                      Real spotPrice,
+                                      const std::vector<Real>& strikes,
+                                      Time term,
+                                      const Date& maturityDate) const;
+
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const ext::shared_ptr<Integration> integration_;
         const Real andersenPiterbargEpsilon_;
+
+        std::vector<Real> strikes_;
+        // call and put values by expiry and strike
+        mutable std::map<std::pair<Date, Real>, std::pair<Real, Real> >
+                                                               cachedValues_;
     };
 
 
@@ -185,8 +232,17 @@ namespace QuantLib {
                        const ext::function<Real(Real)>& f,
                        Real maxBound = Null<Real>()) const;
 
+        // integrates n functions at once; f writes their values at
+        // the given point into its second argument. Only available
+        // for the non-adaptive Gaussian quadratures.
+        Disposable<Array> calculateAll(
+                       Real c_inf,
+                       const ext::function<void(Real, Array&)>& f,
+                       Size n) const;
+
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
+        bool isGaussianQuadrature() const;
 
       private:
         enum Algorithm
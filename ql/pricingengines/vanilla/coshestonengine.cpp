@@ -19,6 +19,7 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -41,6 +42,7 @@ namespace QuantLib {
         sigma_ = model_->sigma();
         rho_   = model_->rho();
         v0_    = model_->v0();
+        cachedValues_.clear();
 
         GenericModelEngine<HestonModel,
                            VanillaOption::arguments,
@@ -78,6 +80,27 @@ namespace QuantLib {
             = process->riskFreeRate()->discount(maturityDate);
         const DiscountFactor qf
             = process->dividendYield()->discount(maturityDate);
+
+        if (!strikes_.empty()) {
+            const std::pair<Date, Real> key(maturityDate, k);
+            if (cachedValues_.find(key) == cachedValues_.end()) {
+                std::vector<Real> strikes(strikes_);
+                if (std::find(strikes.begin(), strikes.end(), k)
+                                                            == strikes.end())
+                    strikes.push_back(k);
+                calculateMultipleStrikes(spot, df, qf, strikes,
+                                         maturity, maturityDate);
+            }
+            const std::pair<Real, Real>& values = cachedValues_[key];
+            if (payoff->optionType() == Option::Put)
+                results_.value = values.second;
+            else if (payoff->optionType() == Option::Call)
+                results_.value = values.first;
+            else
+                QL_FAIL("unknown payoff type");
+            return;
+        }
+
         const Real fwd = spot*qf/df;
         const Real x = std::log(fwd/k);
 
@@ -109,6 +132,59 @@ namespace QuantLib {
             QL_FAIL("unknown payoff type");
     }
 
+    void COSHestonEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedValues_.clear();
+    }
+
+    void COSHestonEngine::calculateMultipleStrikes(
+                                        Real spot,
+                                        DiscountFactor df,
+                                        DiscountFactor qf,
+                                        const std::vector<Real>& strikes,
+                                        Time maturity,
+                                        const Date& maturityDate) const {
+        const Real cum1 = c1(maturity);
+        const Real w = std::sqrt(std::fabs(c2(maturity)));
+        const Real fwd = spot*qf/df;
+
+        // the range [a, b] is centered on x + cum1 for each strike;
+        // as b - a and x - a don't depend on the strike, neither do
+        // the characteristic function terms of the series
+        const Real d = 1.0/(2*L_*w);
+        const Real xMinusA = L_*w - cum1;
+
+        const Real chF0 = chF(0, maturity).real();
+        std::vector<Real> phi(N_);
+        for (Size n=1; n < N_; ++n) {
+            const Real r = n*M_PI*d;
+            phi[n] = (chF(r, maturity)
+                      *std::exp(std::complex<Real>(0, r*xMinusA))).real();
+        }
+
+        for (Size i=0; i < strikes.size(); ++i) {
+            const Real k = strikes[i];
+            const Real x = std::log(fwd/k);
+            const Real a = x - xMinusA;
+
+            const Real expA = std::exp(a);
+            Real s = chF0*(expA-1-a)*d;
+
+            for (Size n=1; n < N_; ++n) {
+                const Real r = n*M_PI*d;
+                const Real U_n = 2.0*d*( 1.0/(1.0 + r*r)
+                    *(expA + r*std::sin(r*a) - std::cos(r*a))
+                    - 1.0/r*std::sin(r*a));
+
+                s += U_n*phi[n];
+            }
+
+            cachedValues_[std::make_pair(maturityDate, k)] =
+                std::make_pair(spot*qf - k*df*(1-s), k*df*s);
+        }
+    }
+
     Real COSHestonEngine::muT(Time t) const {
         return std::log(  model_->process()->dividendYield()->discount(t)
                         / model_->process()->riskFreeRate()->discount(t));
@@ -29,6 +29,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -61,6 +62,16 @@ namespace QuantLib {
         void update();
         void calculate() const;
 
+        //! prices the given strikes together with the requested one
+        /*! When the engine is asked for the value of an option, it
+            also calculates the values of calls and puts on the given
+            strikes with the same expiry and caches them until the
+            model changes.  The truncation range is moved with the
+            strike while keeping its width, so that the characteristic
+            function is evaluated only once for all the strikes.
+        */
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
         // normalized characteristic function
         std::complex<Real> chF(Real u, Real t) const;
 
@@ -77,9 +88,21 @@ namespace QuantLib {
       private:
         Real muT(Time t) const;
 
+        void calculateMultipleStrikes(Real spot,
+                                      DiscountFactor df,
+                                      DiscountFactor qf,
+                                      const std::vector<Real>& strikes,
+                                      Time maturity,
+                                      const Date& maturityDate) const;
+
         const Real L_;
         const Size N_;
         Real kappa_, theta_, sigma_, rho_, v0_;
+
+        std::vector<Real> strikes_;
+        // call and put values by expiry and strike
+        mutable std::map<std::pair<Date, Real>, std::pair<Real, Real> >
+                                                               cachedValues_;
     };
 }
 
@@ -29,33 +29,43 @@
 
 namespace QuantLib {
 
-    Real unsafeSabrVolatility(Rate strike,
-                              Rate forward,
-                              Time expiryTime,
-                              Real alpha,
-                              Real beta,
-                              Real nu,
-                              Real rho) {
-        const Real oneMinusBeta = 1.0-beta;
-        const Real A = std::pow(forward*strike, oneMinusBeta);
+    SabrVolatilityKernel::SabrVolatilityKernel(Rate forward,
+                                               Time expiryTime,
+                                               Real alpha,
+                                               Real beta,
+                                               Real nu,
+                                               Real rho,
+                                               Real shift)
+    : forward_(forward+shift), expiryTime_(expiryTime),
+      alpha_(alpha), rho_(rho), shift_(shift),
+      oneMinusBeta_(1.0-beta),
+      oneMinusBeta2_(oneMinusBeta_*oneMinusBeta_),
+      nuOverAlpha_(nu/alpha),
+      twoRho_(2.0*rho), oneMinusRho_(1.0-rho), halfRho_(0.5*rho),
+      threeRho2MinusTwo_(3.0*rho*rho-2.0),
+      dA_(oneMinusBeta2_*alpha*alpha),
+      dSqrtA_(0.25*rho*beta*nu*alpha),
+      d0_((2.0-3.0*rho*rho)*(nu*nu/24.0)) {}
+
+    Real SabrVolatilityKernel::operator()(Rate strike) const {
+        strike += shift_;
+        const Real A = std::pow(forward_*strike, oneMinusBeta_);
         const Real sqrtA= std::sqrt(A);
         Real logM;
-        if (!close(forward, strike))
-            logM = std::log(forward/strike);
+        if (!close(forward_, strike))
+            logM = std::log(forward_/strike);
         else {
-            const Real epsilon = (forward-strike)/strike;
+            const Real epsilon = (forward_-strike)/strike;
             logM = epsilon - .5 * epsilon * epsilon ;
         }
-        const Real z = (nu/alpha)*sqrtA*logM;
-        const Real B = 1.0-2.0*rho*z+z*z;
-        const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
-        const Real tmp = (std::sqrt(B)+z-rho)/(1.0-rho);
+        const Real z = nuOverAlpha_*sqrtA*logM;
+        const Real B = 1.0-twoRho_*z+z*z;
+        const Real C = oneMinusBeta2_*logM*logM;
+        const Real tmp = (std::sqrt(B)+z-rho_)/oneMinusRho_;
         const Real xx = std::log(tmp);
         const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
-        const Real d = 1.0 + expiryTime *
-            (oneMinusBeta*oneMinusBeta*alpha*alpha/(24.0*A)
-                                + 0.25*rho*beta*nu*alpha/sqrtA
-                                    +(2.0-3.0*rho*rho)*(nu*nu/24.0));
+        const Real d = 1.0 + expiryTime_ *
+            (dA_/(24.0*A) + dSqrtA_/sqrtA + d0_);
 
         Real multiplier;
         // computations become precise enough if the square of z worth
@@ -64,9 +74,28 @@ namespace QuantLib {
         if (std::fabs(z*z)>QL_EPSILON * m)
             multiplier = z/xx;
         else {
-            multiplier = 1.0 - 0.5*rho*z - (3.0*rho*rho-2.0)*z*z/12.0;
+            multiplier = 1.0 - halfRho_*z - threeRho2MinusTwo_*z*z/12.0;
         }
-        return (alpha/D)*multiplier*d;
+        return (alpha_/D)*multiplier*d;
+    }
+
+    void SabrVolatilityKernel::operator()(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Real>& volatilities) const {
+        volatilities.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            volatilities[i] = (*this)(strikes[i]);
+    }
+
+    Real unsafeSabrVolatility(Rate strike,
+                              Rate forward,
+                              Time expiryTime,
+                              Real alpha,
+                              Real beta,
+                              Real nu,
+                              Real rho) {
+        return SabrVolatilityKernel(forward, expiryTime,
+                                    alpha, beta, nu, rho)(strike);
     }
 
     Real unsafeShiftedSabrVolatility(Rate strike,
@@ -29,6 +29,7 @@
 #define quantlib_sabr_hpp
 
 #include <ql/types.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -78,6 +79,32 @@ namespace QuantLib {
                                 Real beta,
                                 Real nu,
                                 Real rho);
+
+    //! Hagan et al. SABR formula for a given smile
+    /*! The terms that don't depend on the strike are calculated
+        once at construction.  The results are the same as those of
+        unsafeShiftedSabrVolatility; as in the latter, the inputs
+        are not checked.
+    */
+    class SabrVolatilityKernel {
+      public:
+        SabrVolatilityKernel(Rate forward,
+                             Time expiryTime,
+                             Real alpha,
+                             Real beta,
+                             Real nu,
+                             Real rho,
+                             Real shift = 0.0);
+        Real operator()(Rate strike) const;
+        //! volatilities at the given strikes
+        void operator()(const std::vector<Rate>& strikes,
+                        std::vector<Real>& volatilities) const;
+      private:
+        Real forward_, expiryTime_, alpha_, rho_, shift_;
+        Real oneMinusBeta_, oneMinusBeta2_, nuOverAlpha_;
+        Real twoRho_, oneMinusRho_, halfRho_, threeRho2MinusTwo_;
+        Real dA_, dSqrtA_, d0_;
+    };
 }
 
 #endif
@@ -19,7 +19,6 @@
 */
 
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
-#include <ql/termstructures/volatility/sabr.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 namespace QuantLib {
@@ -43,6 +42,8 @@ namespace QuantLib {
                        << io::rate(forward_) << " with shift "
                        << io::rate(shift_) << " not allowed");
         validateSabrParameters(alpha_, beta_, nu_, rho_);
+        kernel_ = ext::make_shared<SabrVolatilityKernel>(
+            forward_, exerciseTime(), alpha_, beta_, nu_, rho_, shift_);
     }
 
     SabrSmileSection::SabrSmileSection(const Date& d,
@@ -64,18 +65,34 @@ namespace QuantLib {
                        << io::rate(forward_) << " with shift "
                        << io::rate(shift_) << " not allowed");
         validateSabrParameters(alpha_, beta_, nu_, rho_);
+        kernel_ = ext::make_shared<SabrVolatilityKernel>(
+            forward_, exerciseTime(), alpha_, beta_, nu_, rho_, shift_);
+    }
+
+    void SabrSmileSection::update() {
+        SmileSection::update();
+        // the exercise time might have changed
+        kernel_ = ext::make_shared<SabrVolatilityKernel>(
+            forward_, exerciseTime(), alpha_, beta_, nu_, rho_, shift_);
     }
 
      Real SabrSmileSection::varianceImpl(Rate strike) const {
         strike = std::max(0.00001 - shift(),strike);
-        Volatility vol = unsafeShiftedSabrVolatility(
-            strike, forward_, exerciseTime(), alpha_, beta_, nu_, rho_, shift_);
+        Volatility vol = (*kernel_)(strike);
         return vol * vol * exerciseTime();
      }
 
      Real SabrSmileSection::volatilityImpl(Rate strike) const {
         strike = std::max(0.00001 - shift(),strike);
-        return unsafeShiftedSabrVolatility(strike, forward_, exerciseTime(),
-                                           alpha_, beta_, nu_, rho_, shift_);
+        return (*kernel_)(strike);
+     }
+
+     void SabrSmileSection::volatilitiesImpl(
+                               const std::vector<Rate>& strikes,
+                               std::vector<Volatility>& volatilities) const {
+        const Real minStrike = 0.00001 - shift();
+        volatilities.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            volatilities[i] = (*kernel_)(std::max(minStrike, strikes[i]));
      }
 }
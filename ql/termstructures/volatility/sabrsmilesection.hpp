@@ -26,6 +26,7 @@
 #define quantlib_sabr_smile_section_hpp
 
 #include <ql/termstructures/volatility/smilesection.hpp>
+#include <ql/termstructures/volatility/sabr.hpp>
 #include <ql/time/daycounters/actual365fixed.hpp>
 #include <vector>
 
@@ -45,11 +46,15 @@ namespace QuantLib {
         Real minStrike () const { return -shift_; }
         Real maxStrike () const { return QL_MAX_REAL; }
         Real atmLevel() const { return forward_; }
+        void update();
       protected:
         Real varianceImpl(Rate strike) const;
         Volatility volatilityImpl(Rate strike) const;
+        void volatilitiesImpl(const std::vector<Rate>& strikes,
+                              std::vector<Volatility>& volatilities) const;
       private:
         Real alpha_, beta_, nu_, rho_, forward_, shift_;
+        ext::shared_ptr<SabrVolatilityKernel> kernel_;
     };
 
 
@@ -30,6 +30,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/option.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -56,6 +57,12 @@ namespace QuantLib {
         virtual Real maxStrike() const = 0;
         Real variance(Rate strike) const;
         Volatility volatility(Rate strike) const;
+        /*! volatilities at the given strikes; sections with
+            precomputed strike-independent terms might calculate
+            them faster than by repeated calls to volatility().
+        */
+        void volatilities(const std::vector<Rate>& strikes,
+                          std::vector<Volatility>& volatilities) const;
         virtual Real atmLevel() const = 0;
         virtual const Date& exerciseDate() const { return exerciseDate_; }
         virtual VolatilityType volatilityType() const {
@@ -82,6 +89,9 @@ namespace QuantLib {
         virtual void initializeExerciseTime() const;
         virtual Real varianceImpl(Rate strike) const;
         virtual Volatility volatilityImpl(Rate strike) const = 0;
+        virtual void volatilitiesImpl(
+                               const std::vector<Rate>& strikes,
+                               std::vector<Volatility>& volatilities) const;
       private:
         bool isFloating_;
         mutable Date referenceDate_;
@@ -103,6 +113,12 @@ namespace QuantLib {
         return volatilityImpl(strike);
     }
 
+    inline void SmileSection::volatilities(
+                               const std::vector<Rate>& strikes,
+                               std::vector<Volatility>& volatilities) const {
+        volatilitiesImpl(strikes, volatilities);
+    }
+
     inline const Date& SmileSection::referenceDate() const {
         QL_REQUIRE(referenceDate_!=Date(),
                    "referenceDate not available for this instance");
@@ -114,6 +130,14 @@ namespace QuantLib {
         return v*v*exerciseTime();
     }
 
+    inline void SmileSection::volatilitiesImpl(
+                               const std::vector<Rate>& strikes,
+                               std::vector<Volatility>& volatilities) const {
+        volatilities.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            volatilities[i] = volatilityImpl(strikes[i]);
+    }
+
 }
 
 #endif
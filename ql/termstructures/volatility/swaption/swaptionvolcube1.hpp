@@ -37,6 +37,7 @@
 #include <ql/math/interpolations/backwardflatlinearinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/quote.hpp>
+#include <string>
 
 
 #ifndef SWAPTIONVOLCUBE_VEGAWEIGHTED_TOL
@@ -52,6 +53,26 @@ namespace QuantLib {
     class EndCriteria;
     class OptimizationMethod;
 
+    //! swaption volatility cube with SABR smile sections
+    /*! The SABR sections at the quoted (option tenor, swap tenor)
+        nodes are calibrated independently of each other.  When
+        batch calibration is enabled:
+        - if no optimization method is passed (so that each node
+          uses its own Levenberg-Marquardt instance) and the library
+          was compiled with OpenMP support, the nodes are calibrated
+          concurrently;
+        - nodes whose market volatilities, strikes, forward, shift
+          and parameter guesses didn't change since the previous
+          calibration are not calibrated again;
+        - the other nodes start from their previous parameters,
+          unless their parameter guesses changed.  Fixed parameters
+          always take the value of the guess.
+
+        The same applies to the sections of the ATM-calibrated dense
+        cube.  Without batch calibration, each calibration starts
+        from the parameter guesses and the results don't depend on
+        the previous ones.
+    */
     template<class Model>
     class SwaptionVolCube1x : public SwaptionVolatilityCube {
         class Cube {
@@ -108,6 +129,19 @@ namespace QuantLib {
             mutable std::vector< ext::shared_ptr<Interpolation2D> > interpolators_;
          };
       public:
+        //! outcome of the calibration of a SABR section
+        struct NodeCalibration {
+            NodeCalibration()
+            : rmsError(Null<Real>()), maxError(Null<Real>()),
+              endCriteria(EndCriteria::None),
+              recalibrated(false), warmStarted(false) {}
+            Real rmsError, maxError;
+            EndCriteria::Type endCriteria;
+            //! false if the previous calibration was reused
+            bool recalibrated;
+            //! true if started from the previous calibration
+            bool warmStarted;
+        };
         SwaptionVolCube1x(
             const Handle<SwaptionVolatilityStructure>& atmVolStructure,
             const std::vector<Period>& optionTenors,
@@ -149,6 +183,26 @@ namespace QuantLib {
         Matrix denseSabrParameters() const;
         Matrix marketVolCube() const;
         Matrix volCubeAtmCalibrated() const;
+        /*! diagnostics of the latest calibration of the sparse
+            cube; the node for the i-th option tenor and the j-th
+            swap tenor is at index i*nSwapTenors+j.
+        */
+        const std::vector<NodeCalibration>&
+        sparseCalibrationDiagnostics() const;
+        /*! diagnostics of the latest calibration of the
+            ATM-calibrated dense cube, indexed as above on its
+            option times and swap lengths.
+        */
+        const std::vector<NodeCalibration>&
+        denseCalibrationDiagnostics() const;
+        //@}
+        //! \name Batch calibration
+        //@{
+        void enableBatchCalibration(bool b = true) {
+            batchCalibration_ = b;
+        }
+        void disableBatchCalibration() { batchCalibration_ = false; }
+        bool allowsBatchCalibration() const { return batchCalibration_; }
         //@}
         void sabrCalibrationSection(const Cube& marketVolCube,
                                     Cube& parametersCube,
@@ -174,6 +228,16 @@ namespace QuantLib {
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
                                                  const Period& atmSwapTenor) const;
       private:
+        struct CalibrationCache {
+            // per node: option time, forward, shift, the four
+            // parameter guesses, the strikes and the volatilities
+            std::vector<std::vector<Real> > inputs;
+            // per node: parameters, forward, errors and end criteria
+            std::vector<std::vector<Real> > results;
+            std::vector<NodeCalibration> diagnostics;
+        };
+        Cube sabrCalibration(const Cube& marketVolCube,
+                             CalibrationCache& cache) const;
         Size requiredNumberOfStrikes() const { return 1; }
         mutable Cube marketVolCube_;
         mutable Cube volCubeAtmCalibrated_;
@@ -193,6 +257,8 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        bool batchCalibration_;
+        mutable CalibrationCache sparseCalibration_, denseCalibration_;
 
         class PrivateObserver : public Observer {
           public:
@@ -239,7 +305,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          batchCalibration_(false) {
 
         // the current implementations are all lognormal, if we have
         // a normal one, we can move this check to the implementing classes
@@ -310,7 +377,8 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_,
+                                            sparseCalibration_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -318,7 +386,8 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibration_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -327,7 +396,8 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibration_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
@@ -336,6 +406,14 @@ namespace QuantLib {
     template <class Model>
     typename SwaptionVolCube1x<Model>::Cube
     SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube) const {
+        CalibrationCache cache;
+        return sabrCalibration(marketVolCube, cache);
+    }
+
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::Cube
+    SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube,
+                                              CalibrationCache& cache) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
@@ -352,6 +430,15 @@ namespace QuantLib {
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
+        const Size nNodes = optionTimes.size()*swapLengths.size();
+        const bool reuse =
+            batchCalibration_ && cache.inputs.size() == nNodes;
+        std::vector<std::vector<Real> > inputs(nNodes), results(nNodes);
+        std::vector<NodeCalibration> diagnostics(nNodes);
+        std::vector<Size> nodesToCalibrate;
+
+        // market data are collected sequentially, since the swap
+        // indexes and the ATM structure might not be thread-safe
         std::vector<Real> strikes(strikeSpreads_.size());
         std::vector<Real> volatilities(strikeSpreads_.size());
 
@@ -372,11 +459,65 @@ namespace QuantLib {
                 const std::vector<Real>& guess =
                     parametersGuess_(optionTimes[j], swapLengths[k]);
 
+                const Size n = j*swapLengths.size()+k;
+                std::vector<Real>& input = inputs[n];
+                input.reserve(7+2*strikes.size());
+                input.push_back(optionTimes[j]);
+                input.push_back(atmForward);
+                input.push_back(shiftTmp);
+                input.insert(input.end(), guess.begin(), guess.begin()+4);
+                input.insert(input.end(), strikes.begin(), strikes.end());
+                input.insert(input.end(),
+                             volatilities.begin(), volatilities.end());
+
+                if (reuse && cache.inputs[n] == input) {
+                    results[n] = cache.results[n];
+                    diagnostics[n] = cache.diagnostics[n];
+                    diagnostics[n].recalibrated = false;
+                    diagnostics[n].warmStarted = false;
+                } else {
+                    nodesToCalibrate.push_back(n);
+                }
+            }
+        }
+
+        // each node builds its own optimizer if none was given;
+        // otherwise, the given one is shared and can't be used
+        // concurrently.
+        const bool parallel =
+            batchCalibration_ && !optMethod_ && nodesToCalibrate.size() > 1;
+        // exceptions can't cross the boundary of the parallel region,
+        // even when it is inactive; the one from the first failing node
+        // is rethrown.  In serial mode, no node is fitted after it.
+        std::vector<std::string> failures(nodesToCalibrate.size());
+        bool failed = false;
+
+        #pragma omp parallel for if(parallel) schedule(dynamic)
+        for (long l=0; l < long(nodesToCalibrate.size()); ++l) {
+            if (!parallel && failed)
+                continue;
+            try {
+                const Size n = nodesToCalibrate[l];
+                const std::vector<Real>& input = inputs[n];
+                const Size nPoints = (input.size()-7)/2;
+                std::vector<Real> guess(input.begin()+3, input.begin()+7);
+
+                const bool warmStart = reuse &&
+                    cache.inputs[n].size() == input.size() &&
+                    std::equal(guess.begin(), guess.end(),
+                               cache.inputs[n].begin()+3);
+                if (warmStart) {
+                    for (Size p=0; p<4; ++p)
+                        if (!isParameterFixed_[p])
+                            guess[p] = cache.results[n][p];
+                }
+
+                const std::vector<Real>::const_iterator x = input.begin()+7;
                 const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
                     ext::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
+                                          (typename Model::Interpolation)(x, x+nPoints,
+                                          x+nPoints,
+                                          input[0], input[1],
                                           guess[0], guess[1],
                                           guess[2], guess[3],
                                           isParameterFixed_[0],
@@ -389,19 +530,52 @@ namespace QuantLib {
                                           errorAccept_,
                                           useMaxError_,
                                           maxGuesses_,
-                                          shiftTmp));
+                                          input[2]));
                 sabrInterpolation->update();
 
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
-                errors     [j][k] = rmsError;
-                maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+                std::vector<Real>& result = results[n];
+                result.resize(8);
+                result[0] = sabrInterpolation->alpha();
+                result[1] = sabrInterpolation->beta();
+                result[2] = sabrInterpolation->nu();
+                result[3] = sabrInterpolation->rho();
+                result[4] = input[1];
+                result[5] = sabrInterpolation->rmsError();
+                result[6] = sabrInterpolation->maxError();
+                result[7] = sabrInterpolation->endCriteria();
+
+                diagnostics[n].rmsError = result[5];
+                diagnostics[n].maxError = result[6];
+                diagnostics[n].endCriteria = sabrInterpolation->endCriteria();
+                diagnostics[n].recalibrated = true;
+                diagnostics[n].warmStarted = warmStart;
+            } catch (std::exception& e) {
+                failures[l] = e.what();
+                if (failures[l].empty())
+                    failures[l] = "unknown error";
+            } catch (...) {
+                failures[l] = "unknown error";
+            }
+            if (!parallel && !failures[l].empty())
+                failed = true;
+        }
+        for (Size l=0; l<failures.size(); ++l)
+            QL_REQUIRE(failures[l].empty(), failures[l]);
+
+        for (Size j=0; j<optionTimes.size(); j++) {
+            for (Size k=0; k<swapLengths.size(); k++) {
+                const std::vector<Real>& result =
+                    results[j*swapLengths.size()+k];
+                alphas     [j][k] = result[0];
+                betas      [j][k] = result[1];
+                nus        [j][k] = result[2];
+                rhos       [j][k] = result[3];
+                forwards   [j][k] = result[4];
+                errors     [j][k] = result[5];
+                maxErrors  [j][k] = result[6];
+                endCriteria[j][k] = result[7];
+                Real rmsError = result[5];
+                Real maxError = result[6];
 
                 QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
@@ -444,6 +618,10 @@ namespace QuantLib {
         sabrParametersCube.setLayer(6, maxErrors);
         sabrParametersCube.setLayer(7, endCriteria);
 
+        cache.inputs.swap(inputs);
+        cache.results.swap(results);
+        cache.diagnostics.swap(diagnostics);
+
         return sabrParametersCube;
 
     }
@@ -799,6 +977,20 @@ namespace QuantLib {
         return denseParameters_.browse();
     }
 
+    template <class Model>
+    const std::vector<typename SwaptionVolCube1x<Model>::NodeCalibration>&
+    SwaptionVolCube1x<Model>::sparseCalibrationDiagnostics() const {
+        calculate();
+        return sparseCalibration_.diagnostics;
+    }
+
+    template <class Model>
+    const std::vector<typename SwaptionVolCube1x<Model>::NodeCalibration>&
+    SwaptionVolCube1x<Model>::denseCalibrationDiagnostics() const {
+        calculate();
+        return denseCalibration_.diagnostics;
+    }
+
     template<class Model> Matrix SwaptionVolCube1x<Model>::marketVolCube() const {
         calculate();
         return marketVolCube_.browse();
@@ -22,9 +22,195 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/scoped_array.hpp>
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+#include <atomic>
+#else
+#include <boost/atomic.hpp>
+#endif
+#include <algorithm>
+
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN) \
+    || defined(QL_ENABLE_SINGLETON_THREAD_SAFE_INIT) || defined(_OPENMP)
+#define QL_LOCK_BUSINESS_DAYS
+#include <boost/thread/mutex.hpp>
+#endif
 
 namespace QuantLib {
 
+    namespace {
+
+        Integer bitCount(boost::uint64_t x) {
+            x = x - ((x >> 1) & UINT64_C(0x5555555555555555));
+            x = (x & UINT64_C(0x3333333333333333))
+                + ((x >> 2) & UINT64_C(0x3333333333333333));
+            x = (x + (x >> 4)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+            return Integer((x * UINT64_C(0x0101010101010101)) >> 56);
+        }
+
+        // number of set bits before the k-th one
+        Integer rank(const boost::uint64_t* days, Day k) {
+            Integer r = 0;
+            for (Day i=0; i<k/64; ++i)
+                r += bitCount(days[i]);
+            if (k%64 != 0)
+                r += bitCount(days[k/64] & ((UINT64_C(1) << (k%64)) - 1));
+            return r;
+        }
+
+        // position of the n-th set bit (n >= 1); the caller must make
+        // sure that there are enough
+        Day select(const boost::uint64_t* days, Integer n) {
+            Day i = 0;
+            Integer c;
+            while (n > (c = bitCount(days[i]))) {
+                n -= c;
+                ++i;
+            }
+            boost::uint64_t w = days[i];
+            for (Integer j=1; j<n; ++j)
+                w &= w - 1;
+            Day k = 0;
+            while ((w & 1) == 0) {
+                w >>= 1;
+                ++k;
+            }
+            return i*64 + k;
+        }
+
+    }
+
+    // Business days of a calendar implementation.  The bitmap of each
+    // year is allocated the first time the year is queried, and is
+    // built under the lock at most once for each version of the
+    // calendar; it is published by storing that version after its
+    // bits, so that queries of years already built don't need to lock.
+    class Calendar::Impl::BusinessDays : private boost::noncopyable {
+      public:
+        #if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+        typedef std::atomic<unsigned long> version_type;
+        #else
+        typedef boost::atomic<unsigned long> version_type;
+        #endif
+        struct YearDays : private boost::noncopyable {
+            YearDays() { built.store(0); }
+            // one bit per day
+            boost::uint64_t days[wordsPerYear];
+            // business days in the year
+            Integer count;
+            // version of the calendar for which the year was built
+            version_type built;
+        };
+        #if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+        typedef std::atomic<YearDays*> year_pointer;
+        #else
+        typedef boost::atomic<YearDays*> year_pointer;
+        #endif
+        static const Size years = 2199 - 1901 + 1;
+        BusinessDays() : data(new year_pointer[years]) {
+            version.store(1);
+            for (Size i=0; i<years; ++i)
+                data[i].store(0);
+        }
+        ~BusinessDays() {
+            for (Size i=0; i<years; ++i)
+                delete data[i].load();
+        }
+        // increased when holidays are added or removed
+        version_type version;
+        boost::scoped_array<year_pointer> data;
+        #if defined(QL_LOCK_BUSINESS_DAYS)
+        boost::mutex mutex;
+        #endif
+    };
+
+    Calendar::Impl::Impl() : businessDays_(new BusinessDays) {}
+
+    unsigned long Calendar::Impl::businessDaysVersion() const {
+        return businessDays_->version.load();
+    }
+
+    void Calendar::resetBusinessDays() {
+        ++impl_->businessDays_->version;
+    }
+
+    unsigned long Calendar::businessDaysVersion() const {
+        return impl_ ? impl_->businessDaysVersion() : 0;
+    }
+
+    void Calendar::Impl::fillBusinessDays(Year y,
+                                          boost::uint64_t* days) const {
+        const Date first(1, January, y);
+        const Day n = Date::isLeap(y) ? 366 : 365;
+        // no increment past the last day, as that might be maxDate()
+        for (Day k = 0; k < n; ++k) {
+            if (isBusinessDay(first + k))
+                days[k/64] |= UINT64_C(1) << (k%64);
+        }
+    }
+
+    const boost::uint64_t* Calendar::businessDays(Year y) const {
+        Impl::BusinessDays& cache = *impl_->businessDays_;
+        const Size i = y - 1901;
+        const unsigned long version = impl_->businessDaysVersion();
+
+        #if !defined(BOOST_NO_CXX11_HDR_ATOMIC)
+        using std::memory_order_acquire;
+        using std::memory_order_relaxed;
+        using std::memory_order_release;
+        #else
+        using boost::memory_order_acquire;
+        using boost::memory_order_relaxed;
+        using boost::memory_order_release;
+        #endif
+
+        Impl::BusinessDays::YearDays* year =
+            cache.data[i].load(memory_order_acquire);
+        if (year != 0 && year->built.load(memory_order_acquire) == version)
+            return year->days;
+
+        #if defined(QL_LOCK_BUSINESS_DAYS)
+        boost::mutex::scoped_lock lock(cache.mutex);
+        #endif
+        year = cache.data[i].load(memory_order_relaxed);
+        if (year == 0) {
+            // not built yet, so that readers will go for the lock
+            year = new Impl::BusinessDays::YearDays;
+            cache.data[i].store(year, memory_order_release);
+        } else if (year->built.load(memory_order_relaxed) == version) {
+            return year->days;
+        }
+
+        boost::uint64_t* days = year->days;
+        std::fill(days, days+wordsPerYear, 0);
+        impl_->fillBusinessDays(y, days);
+
+        const Date first(1, January, y), last(31, December, y);
+        Day k;
+        std::set<Date>::const_iterator j;
+        for (j = impl_->addedHolidays.lower_bound(first);
+             j != impl_->addedHolidays.end() && *j <= last; ++j) {
+            k = j->dayOfYear() - 1;
+            days[k/64] &= ~(UINT64_C(1) << (k%64));
+        }
+        for (j = impl_->removedHolidays.lower_bound(first);
+             j != impl_->removedHolidays.end() && *j <= last; ++j) {
+            k = j->dayOfYear() - 1;
+            days[k/64] |= UINT64_C(1) << (k%64);
+        }
+        year->count = rank(days, 64*wordsPerYear);
+
+        year->built.store(version, memory_order_release);
+        return days;
+    }
+
+    Integer Calendar::businessDaysInYear(Year y) const {
+        businessDays(y);
+        // published by the call above
+        return impl_->businessDays_->data[y-1901].load()->count;
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no calendar implementation provided");
 
@@ -40,6 +226,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(_d))
             impl_->addedHolidays.insert(_d);
+        resetBusinessDays();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -57,6 +244,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(_d))
             impl_->removedHolidays.insert(_d);
+        resetBusinessDays();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -113,23 +301,35 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
-            Date d1 = d;
+            QL_REQUIRE(impl_, "no calendar implementation provided");
+            Year y = d.year();
+            const Day k = d.dayOfYear() - 1;
+            // r is the rank of the target business day within year y
+            Integer r;
             if (n > 0) {
-                while (n > 0) {
-                    d1++;
-                    while (isHoliday(d1))
-                        d1++;
-                    n--;
+                r = rank(businessDays(y), k+1) + n;
+                Integer c;
+                while (r > (c = businessDaysInYear(y))) {
+                    r -= c;
+                    ++y;
+                    QL_REQUIRE(y <= Date::maxDate().year(),
+                               "cannot advance " << d << " by " << n
+                               << " business days: date out of range");
                 }
             } else {
-                while (n < 0) {
-                    d1--;
-                    while(isHoliday(d1))
-                        d1--;
-                    n++;
+                r = rank(businessDays(y), k) + n + 1;
+                while (r <= 0) {
+                    --y;
+                    QL_REQUIRE(y >= Date::minDate().year(),
+                               "cannot advance " << d << " by " << n
+                               << " business days: date out of range");
+                    r += businessDaysInYear(y);
                 }
             }
-            return d1;
+            const Day k1 = select(businessDays(y), r);
+            // adding the offset preserves the time of day, if any
+            return d + (Date(1, January, y).serialNumber() + k1
+                        - d.serialNumber());
         } else if (unit == Weeks) {
             Date d1 = d + n*unit;
             return adjust(d1,c);
@@ -155,25 +355,17 @@ namespace QuantLib {
                                                     const Date& to,
                                                     bool includeFirst,
                                                     bool includeLast) const {
+        QL_REQUIRE(impl_, "no calendar implementation provided");
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
-                // the last one is treated separately to avoid
-                // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(from))
-                    ++wd;
-            }
+            const Date& d1 = std::min(from, to);
+            const Date& d2 = std::max(from, to);
+            const Year y1 = d1.year(), y2 = d2.year();
+            // business days in [d1, d2]
+            wd = rank(businessDays(y2), d2.dayOfYear())
+               - rank(businessDays(y1), d1.dayOfYear() - 1);
+            for (Year y = y1; y < y2; ++y)
+                wd += businessDaysInYear(y);
 
             if (isBusinessDay(from) && !includeFirst)
                 wd--;
@@ -30,6 +30,7 @@
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
 #include <ql/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
 #include <set>
 #include <vector>
 #include <string>
@@ -52,6 +53,21 @@ namespace QuantLib {
 
         \ingroup datetime
 
+        Business days are cached as a bitmap, allocated and built
+        lazily one year at a time the first time a date in that year
+        is queried.  Checking a date is therefore a bit test, while
+        advancing a date or counting the business days between two
+        dates only requires the bit counts of the words involved.
+        The cache is rebuilt whenever a holiday is added to or
+        removed from the calendar, or from the ones it's based upon
+        (e.g., the components of a JointCalendar).
+
+        If the library was compiled with OpenMP or with one of the
+        thread-safety options, queries can be run concurrently: each
+        year is built under a lock and published before it is used
+        without one.  Adding or removing holidays must not happen
+        concurrently with queries.
+
         \test the methods for adding and removing holidays are tested
               by inspecting the calendar before and after their
               invocation.
@@ -61,13 +77,53 @@ namespace QuantLib {
         //! abstract base class for calendar implementations
         class Impl {
           public:
+            Impl();
             virtual ~Impl() {}
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
+            //! sets the bits of the business days in the given year
+            /*! Bit k of the array stands for the k-th day of the year
+                (starting from 0); the array is zeroed by the caller.
+                Added and removed holidays are applied afterwards
+                and must not be taken into account.
+
+                The default implementation calls isBusinessDay() for
+                each day of the year; implementations that can do
+                better, such as the one of JointCalendar, can
+                override it.
+            */
+            virtual void fillBusinessDays(Year,
+                                          boost::uint64_t* days) const;
+            //! version of the business days
+            /*! The default implementation returns a counter
+                increased whenever holidays are added to or removed
+                from the calendar.  Implementations based on other
+                calendars, such as the one of JointCalendar, must add
+                the versions of the latter, so that their business
+                days are rebuilt when those change.
+            */
+            virtual unsigned long businessDaysVersion() const;
             std::set<Date> addedHolidays, removedHolidays;
+          private:
+            friend class Calendar;
+            class BusinessDays;
+            ext::shared_ptr<BusinessDays> businessDays_;
         };
         ext::shared_ptr<Impl> impl_;
+        //! resets the business-day cache of the calendar
+        /*! To be called by derived calendars whenever a change to
+            their implementation affects which days are business days.
+        */
+        void resetBusinessDays();
+        //! words in the business-day bitmap of a year
+        static const Size wordsPerYear = 6;
+        //! business-day bitmap of the given calendar for the given year
+        /*! The returned array includes added and removed holidays;
+            its contents stay valid until the next change to the
+            calendar or to the ones it's based upon.
+        */
+        static const boost::uint64_t* businessDays(const Calendar&, Year);
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -114,6 +170,12 @@ namespace QuantLib {
         void addHoliday(const Date&);
         /*! Removes a date from the set of holidays for the given calendar. */
         void removeHoliday(const Date&);
+        /*! Returns a counter that changes whenever holidays are added
+            to or removed from the calendar, or from the ones it's
+            based upon.  Caches of results that depend on the calendar
+            can use it to detect stale entries.
+        */
+        unsigned long businessDaysVersion() const;
 
         //! Returns the holidays between two dates
         static std::vector<Date> holidayList(const Calendar& calendar,
@@ -175,6 +237,9 @@ namespace QuantLib {
             //! expressed relative to first day of year
             static Day easterMonday(Year);
         };
+      private:
+        const boost::uint64_t* businessDays(Year) const;
+        Integer businessDaysInYear(Year) const;
     };
 
     /*! Returns <tt>true</tt> iff the two calendars belong to the same
@@ -211,21 +276,17 @@ namespace QuantLib {
         return impl_->removedHolidays;
     }
 
+    inline const boost::uint64_t* Calendar::businessDays(const Calendar& c,
+                                                         Year y) {
+        QL_REQUIRE(c.impl_, "no calendar implementation provided");
+        return c.businessDays(y);
+    }
+
     inline bool Calendar::isBusinessDay(const Date& d) const {
         QL_REQUIRE(impl_, "no calendar implementation provided");
-
-#ifdef QL_HIGH_RESOLUTION_DATE
-        const Date _d(d.dayOfMonth(), d.month(), d.year());
-#else
-        const Date& _d = d;
-#endif
-
-        if (impl_->addedHolidays.find(_d) != impl_->addedHolidays.end())
-            return false;
-        if (impl_->removedHolidays.find(_d) != impl_->removedHolidays.end())
-            return true;
-
-        return impl_->isBusinessDay(_d);
+        const Day k = d.dayOfYear() - 1;
+        const boost::uint64_t* days = businessDays(d.year());
+        return ((days[k/64] >> (k%64)) & 1) != 0;
     }
 
     inline bool Calendar::isEndOfMonth(const Date& d) const {
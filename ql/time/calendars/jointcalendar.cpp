@@ -21,6 +21,7 @@
 
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
 #include <sstream>
 
 namespace QuantLib {
@@ -121,6 +122,40 @@ namespace QuantLib {
         }
     }
 
+    void JointCalendar::Impl::fillBusinessDays(Year y,
+                                               boost::uint64_t* days) const {
+        std::vector<Calendar>::const_iterator i = calendars_.begin();
+        const boost::uint64_t* other = businessDays(*i, y);
+        std::copy(other, other+wordsPerYear, days);
+        switch (rule_) {
+          case JoinHolidays:
+            for (++i; i!=calendars_.end(); ++i) {
+                other = businessDays(*i, y);
+                for (Size k=0; k<wordsPerYear; ++k)
+                    days[k] &= other[k];
+            }
+            break;
+          case JoinBusinessDays:
+            for (++i; i!=calendars_.end(); ++i) {
+                other = businessDays(*i, y);
+                for (Size k=0; k<wordsPerYear; ++k)
+                    days[k] |= other[k];
+            }
+            break;
+          default:
+            QL_FAIL("unknown joint calendar rule");
+        }
+    }
+
+    unsigned long JointCalendar::Impl::businessDaysVersion() const {
+        // versions only increase, so that the sum changes with any of them
+        unsigned long version = Calendar::Impl::businessDaysVersion();
+        std::vector<Calendar>::const_iterator i;
+        for (i=calendars_.begin(); i!=calendars_.end(); ++i)
+            version += i->businessDaysVersion();
+        return version;
+    }
+
 
     JointCalendar::JointCalendar(const Calendar& c1,
                                  const Calendar& c2,
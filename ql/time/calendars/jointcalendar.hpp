@@ -47,6 +47,12 @@ namespace QuantLib {
         business days given by either the union or the intersection
         of the sets of business days of the given calendars.
 
+        The business days of each year are obtained by combining
+        the cached business-day bitmaps of the given calendars a
+        word at a time; therefore, once built, the joint calendar
+        is as fast as a single one.  Holidays added to or removed
+        from the given calendars are taken into account.
+
         \ingroup calendars
 
         \test the correctness of the returned results is tested by
@@ -68,6 +74,8 @@ namespace QuantLib {
             std::string name() const;
             bool isWeekend(Weekday) const;
             bool isBusinessDay(const Date&) const;
+            void fillBusinessDays(Year, boost::uint64_t* days) const;
+            unsigned long businessDaysVersion() const;
           private:
             JointCalendarRule rule_;
             std::vector<Calendar> calendars_;
@@ -51,28 +51,17 @@ using boost::posix_time::time_duration;
 namespace QuantLib {
 #ifndef QL_HIGH_RESOLUTION_DATE
     // constructors
-    Date::Date()
-    : serialNumber_(Date::serial_type(0)) {}
-
-    Date::Date(Date::serial_type serialNumber)
-    : serialNumber_(serialNumber) {
-        checkSerialNumber(serialNumber);
-    }
-
-    Date::Date(Day d, Month m, Year y) {
+    void Date::checkDate(Day d, Month m, Year y) {
         QL_REQUIRE(y > 1900 && y < 2200,
                    "year " << y << " out of bound. It must be in [1901,2199]");
         QL_REQUIRE(Integer(m) > 0 && Integer(m) < 13,
                    "month " << Integer(m)
                    << " outside January-December range [1,12]");
 
-        bool leap = isLeap(y);
-        Day len = monthLength(m,leap), offset = monthOffset(m,leap);
+        Day len = monthLength(m,isLeap(y));
         QL_REQUIRE(d <= len && d > 0,
                    "day outside month (" << Integer(m) << ") day-range "
                    << "[1," << len << "]");
-
-        serialNumber_ = d + offset + yearOffset(y);
     }
 
     Month Date::month() const {
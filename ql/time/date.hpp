@@ -249,6 +249,7 @@ namespace QuantLib {
         boost::posix_time::ptime dateTime_;
 #else
         Date::serial_type serialNumber_;
+        static void checkDate(Day d, Month m, Year y);
         static Date advance(const Date& d, Integer units, TimeUnit);
         static Integer monthLength(Month m, bool leapYear);
         static Integer monthOffset(Month m, bool leapYear);
@@ -358,6 +359,41 @@ namespace QuantLib {
 #ifndef QL_HIGH_RESOLUTION_DATE
     // inline definitions
 
+    inline Date::Date()
+    : serialNumber_(Date::serial_type(0)) {}
+
+    inline Date::Date(Date::serial_type serialNumber)
+    : serialNumber_(serialNumber) {
+        // same bounds as minimumSerialNumber() and maximumSerialNumber();
+        // the error is reported out of line
+        if (serialNumber < 367 || serialNumber > 109574)
+            checkSerialNumber(serialNumber);
+    }
+
+    inline Date::Date(Day d, Month m, Year y) {
+        // The offsets are calculated arithmetically rather than looked
+        // up in tables, so that the compiler can fold dates built from
+        // constants; errors are reported out of line.
+        const bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+        const Integer mm = Integer(m);
+        const Day length = mm == 2 ? (leap ? 29 : 28)
+                                   : 30 + ((mm + mm/8) & 1);
+        if (y <= 1900 || y >= 2200 || mm < 1 || mm > 12
+            || d < 1 || d > length)
+            checkDate(d, m, y);
+
+        const Integer monthStart =
+            (367*mm - 362)/12 - (mm > 2 ? (leap ? 1 : 2) : 0);
+        // December 31st of the preceding year; 460 is the number of
+        // leap years up to 1900 included, which is counted as leap
+        // for compatibility with Excel.
+        const Year py = y - 1;
+        const Date::serial_type yearStart =
+            365*(y-1900) + 1 + (py/4 - py/100 + py/400) - 460;
+
+        serialNumber_ = d + monthStart + yearStart;
+    }
+
     inline Weekday Date::weekday() const {
         Integer w = serialNumber_ % 7;
         return Weekday(w == 0 ? 7 : w);
@@ -56,6 +56,31 @@ namespace QuantLib {
                                       const Date& d2,
                                       const Date& refPeriodStart,
                                       const Date& refPeriodEnd) const = 0;
+            //! to be overloaded by day counters providing faster loops
+            virtual void dayCounts(const Date* d1,
+                                   const Date* d2,
+                                   Date::serial_type* out,
+                                   Size n) const {
+                for (Size i=0; i<n; ++i)
+                    out[i] = dayCount(d1[i], d2[i]);
+            }
+            //! to be overloaded by day counters providing faster loops
+            virtual void yearFractions(const Date* d1,
+                                       const Date* d2,
+                                       Time* out,
+                                       Size n) const {
+                for (Size i=0; i<n; ++i)
+                    out[i] = yearFraction(d1[i], d2[i], Date(), Date());
+            }
+          protected:
+            //! actual number of days, for use by derived classes
+            static void actualDayCounts(const Date* d1,
+                                        const Date* d2,
+                                        Date::serial_type* out,
+                                        Size n) {
+                for (Size i=0; i<n; ++i)
+                    out[i] = d2[i] - d1[i];
+            }
         };
         ext::shared_ptr<Impl> impl_;
         /*! This constructor can be invoked by derived classes which
@@ -87,6 +112,20 @@ namespace QuantLib {
                           const Date& refPeriodStart = Date(),
                           const Date& refPeriodEnd = Date()) const;
         //@}
+        //! \name Bulk calculations
+        /*! These methods are equivalent to calling dayCount() or
+            yearFraction() (without reference period) on each pair
+            <tt>(d1[i], d2[i])</tt> for <tt>i</tt> in <tt>[0, n)</tt>
+            and storing the results in <tt>out[i]</tt>.  They only
+            dispatch once on the convention; the most common day
+            counters also provide specialized inner loops.
+        */
+        //@{
+        void dayCounts(const Date* d1, const Date* d2,
+                       Date::serial_type* out, Size n) const;
+        void yearFractions(const Date* d1, const Date* d2,
+                           Time* out, Size n) const;
+        //@}
     };
 
     // comparison based on name
@@ -131,6 +170,20 @@ namespace QuantLib {
     }
 
 
+    inline void DayCounter::dayCounts(const Date* d1, const Date* d2,
+                                      Date::serial_type* out,
+                                      Size n) const {
+        QL_REQUIRE(impl_, "no day counter implementation provided");
+        impl_->dayCounts(d1,d2,out,n);
+    }
+
+    inline void DayCounter::yearFractions(const Date* d1, const Date* d2,
+                                          Time* out, Size n) const {
+        QL_REQUIRE(impl_, "no day counter implementation provided");
+        impl_->yearFractions(d1,d2,out,n);
+    }
+
+
     inline bool operator==(const DayCounter& d1, const DayCounter& d2) {
         return (d1.empty() && d2.empty())
             || (!d1.empty() && !d2.empty() && d1.name() == d2.name());
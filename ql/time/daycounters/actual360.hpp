@@ -58,6 +58,22 @@ namespace QuantLib {
                 return (daysBetween(d1,d2)
                         + (includeLastDay_ ? 1.0 : 0.0))/360.0;
             }
+            void dayCounts(const Date* d1,
+                           const Date* d2,
+                           Date::serial_type* out,
+                           Size n) const {
+                const Date::serial_type extra = includeLastDay_ ? 1 : 0;
+                for (Size i=0; i<n; ++i)
+                    out[i] = (d2[i]-d1[i]) + extra;
+            }
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* out,
+                               Size n) const {
+                const Real extra = includeLastDay_ ? 1.0 : 0.0;
+                for (Size i=0; i<n; ++i)
+                    out[i] = (daysBetween(d1[i],d2[i]) + extra)/360.0;
+            }
         };
       public:
         explicit Actual360(const bool includeLastDay = false)
@@ -58,6 +58,19 @@ namespace QuantLib {
                               const Date&) const {
                 return daysBetween(d1,d2)/365.0;
             }
+            void dayCounts(const Date* d1,
+                           const Date* d2,
+                           Date::serial_type* out,
+                           Size n) const {
+                actualDayCounts(d1, d2, out, n);
+            }
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* out,
+                               Size n) const {
+                for (Size i=0; i<n; ++i)
+                    out[i] = daysBetween(d1[i],d2[i])/365.0;
+            }
         };
         class CA_Impl : public DayCounter::Impl {
           public:
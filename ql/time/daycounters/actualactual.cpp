@@ -18,6 +18,7 @@
 */
 
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/utilities/null.hpp>
 #include <algorithm>
 
 namespace QuantLib {
@@ -268,6 +269,44 @@ namespace QuantLib {
         return sum;
     }
 
+    void ActualActual::ISDA_Impl::yearFractions(const Date* d1,
+                                                const Date* d2,
+                                                Time* out,
+                                                Size n) const {
+        // consecutive pairs usually fall in the same years, so we
+        // keep the boundaries of the last years we used.
+        Integer y1 = Null<Integer>(), y2 = Null<Integer>();
+        Date end1, start2;
+        Real dib1 = 0.0, dib2 = 0.0;
+        for (Size i=0; i<n; ++i) {
+            if (d1[i] == d2[i]) {
+                out[i] = 0.0;
+                continue;
+            }
+
+            const bool reversed = d1[i] > d2[i];
+            const Date& from = reversed ? d2[i] : d1[i];
+            const Date& to = reversed ? d1[i] : d2[i];
+
+            Integer yFrom = from.year(), yTo = to.year();
+            if (yFrom != y1) {
+                y1 = yFrom;
+                end1 = Date(1,January,y1+1);
+                dib1 = (Date::isLeap(y1) ? 366.0 : 365.0);
+            }
+            if (yTo != y2) {
+                y2 = yTo;
+                start2 = Date(1,January,y2);
+                dib2 = (Date::isLeap(y2) ? 366.0 : 365.0);
+            }
+
+            Time sum = y2 - y1 - 1;
+            sum += daysBetween(from, end1)/dib1;
+            sum += daysBetween(start2, to)/dib2;
+            out[i] = reversed ? -sum : sum;
+        }
+    }
+
 
     Time ActualActual::AFB_Impl::yearFraction(const Date& d1,
                                               const Date& d2,
@@ -87,6 +87,16 @@ namespace QuantLib {
                               const Date& d2,
                               const Date&,
                               const Date&) const;
+            void dayCounts(const Date* d1,
+                           const Date* d2,
+                           Date::serial_type* out,
+                           Size n) const {
+                actualDayCounts(d1, d2, out, n);
+            }
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* out,
+                               Size n) const;
         };
         class AFB_Impl : public DayCounter::Impl {
           public:
@@ -42,54 +42,158 @@ namespace QuantLib {
         }
     }
 
+    namespace {
+
+        struct YMD {
+            Integer year, month, day;
+        };
+
+        // converts a date to year, month and day in a single pass over
+        // its serial number (days from the civil calendar algorithm by
+        // H. Hinnant; serial number 25569 is January 1st, 1970.)
+        inline YMD ymd(const Date& date) {
+            Integer z = Integer(date.serialNumber()) - 25569 + 719468;
+            Integer era = z / 146097;
+            Integer doe = z - era * 146097;
+            Integer yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+            Integer doy = doe - (365*yoe + yoe/4 - yoe/100);
+            Integer mp = (5*doy + 2) / 153;
+            YMD result;
+            result.day = doy - (153*mp + 2)/5 + 1;
+            result.month = mp < 10 ? mp + 3 : mp - 9;
+            result.year = yoe + era*400 + (result.month <= 2 ? 1 : 0);
+            return result;
+        }
+
+        inline Date::serial_type days360(const YMD& d1, Integer dd1,
+                                         const YMD& d2, Integer dd2) {
+            return 360*(d2.year-d1.year) + 30*(d2.month-d1.month-1) +
+                std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+        }
+
+        inline bool isEndOfFebruary(const YMD& d) {
+            return d.month == 2
+                && d.day == 28 + (Date::isLeap(d.year) ? 1 : 0);
+        }
+
+        struct US {
+            Date::serial_type operator()(const Date& d1,
+                                         const Date& d2) const {
+                YMD a = ymd(d1), b = ymd(d2);
+                if (b.day == 31 && a.day < 30) { b.day = 1; b.month++; }
+                return days360(a, a.day, b, b.day);
+            }
+        };
+
+        struct EU {
+            Date::serial_type operator()(const Date& d1,
+                                         const Date& d2) const {
+                YMD a = ymd(d1), b = ymd(d2);
+                return days360(a, a.day, b, b.day);
+            }
+        };
+
+        struct IT {
+            Date::serial_type operator()(const Date& d1,
+                                         const Date& d2) const {
+                YMD a = ymd(d1), b = ymd(d2);
+                Integer dd1 = (a.month == 2 && a.day > 27) ? 30 : a.day;
+                Integer dd2 = (b.month == 2 && b.day > 27) ? 30 : b.day;
+                return days360(a, dd1, b, dd2);
+            }
+        };
+
+        struct GER {
+            explicit GER(bool isLastPeriod) : isLastPeriod(isLastPeriod) {}
+            Date::serial_type operator()(const Date& d1,
+                                         const Date& d2) const {
+                YMD a = ymd(d1), b = ymd(d2);
+                Integer dd1 = isEndOfFebruary(a) ? 30 : a.day;
+                Integer dd2 = (!isLastPeriod && isEndOfFebruary(b)) ?
+                    30 : b.day;
+                return days360(a, dd1, b, dd2);
+            }
+            bool isLastPeriod;
+        };
+
+        template <class F>
+        void countDays(F f, const Date* d1, const Date* d2,
+                       Date::serial_type* out, Size n) {
+            for (Size i=0; i<n; ++i)
+                out[i] = f(d1[i], d2[i]);
+        }
+
+        template <class F>
+        void countYearFractions(F f, const Date* d1, const Date* d2,
+                                Time* out, Size n) {
+            for (Size i=0; i<n; ++i)
+                out[i] = f(d1[i], d2[i])/360.0;
+        }
+
+    }
+
     Date::serial_type Thirty360::US_Impl::dayCount(const Date& d1,
                                                    const Date& d2) const {
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Integer mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
+        return US()(d1, d2);
+    }
 
-        if (dd2 == 31 && dd1 < 30) { dd2 = 1; mm2++; }
+    void Thirty360::US_Impl::dayCounts(const Date* d1, const Date* d2,
+                                       Date::serial_type* out,
+                                       Size n) const {
+        countDays(US(), d1, d2, out, n);
+    }
 
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+    void Thirty360::US_Impl::yearFractions(const Date* d1, const Date* d2,
+                                           Time* out, Size n) const {
+        countYearFractions(US(), d1, d2, out, n);
     }
 
     Date::serial_type Thirty360::EU_Impl::dayCount(const Date& d1,
                                                    const Date& d2) const {
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Month mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
+        return EU()(d1, d2);
+    }
+
+    void Thirty360::EU_Impl::dayCounts(const Date* d1, const Date* d2,
+                                       Date::serial_type* out,
+                                       Size n) const {
+        countDays(EU(), d1, d2, out, n);
+    }
 
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+    void Thirty360::EU_Impl::yearFractions(const Date* d1, const Date* d2,
+                                           Time* out, Size n) const {
+        countYearFractions(EU(), d1, d2, out, n);
     }
 
     Date::serial_type Thirty360::IT_Impl::dayCount(const Date& d1,
                                                    const Date& d2) const {
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Month mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
+        return IT()(d1, d2);
+    }
 
-        if (mm1 == 2 && dd1 > 27) dd1 = 30;
-        if (mm2 == 2 && dd2 > 27) dd2 = 30;
+    void Thirty360::IT_Impl::dayCounts(const Date* d1, const Date* d2,
+                                       Date::serial_type* out,
+                                       Size n) const {
+        countDays(IT(), d1, d2, out, n);
+    }
 
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+    void Thirty360::IT_Impl::yearFractions(const Date* d1, const Date* d2,
+                                           Time* out, Size n) const {
+        countYearFractions(IT(), d1, d2, out, n);
     }
 
     Date::serial_type Thirty360::GER_Impl::dayCount(const Date& d1,
                                                     const Date& d2) const {
-        Day dd1 = d1.dayOfMonth(), dd2 = d2.dayOfMonth();
-        Month mm1 = d1.month(), mm2 = d2.month();
-        Year yy1 = d1.year(), yy2 = d2.year();
+        return GER(isLastPeriod_)(d1, d2);
+    }
 
-        if (mm1 == 2 && dd1 == 28 + (Date::isLeap(yy1) ? 1 : 0))
-            dd1 = 30;
-        if (!isLastPeriod_ && mm2 == 2 && dd2 == 28 + (Date::isLeap(yy2) ? 1 : 0))
-            dd2 = 30;
+    void Thirty360::GER_Impl::dayCounts(const Date* d1, const Date* d2,
+                                        Date::serial_type* out,
+                                        Size n) const {
+        countDays(GER(isLastPeriod_), d1, d2, out, n);
+    }
 
-        return 360*(yy2-yy1) + 30*(mm2-mm1-1) +
-            std::max(Integer(0),30-dd1) + std::min(Integer(30),dd2);
+    void Thirty360::GER_Impl::yearFractions(const Date* d1, const Date* d2,
+                                            Time* out, Size n) const {
+        countYearFractions(GER(isLastPeriod_), d1, d2, out, n);
     }
 
 }
@@ -74,6 +74,14 @@ namespace QuantLib {
                               const Date&,
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void dayCounts(const Date* d1,
+                           const Date* d2,
+                           Date::serial_type* out,
+                           Size n) const;
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* out,
+                               Size n) const;
         };
         class EU_Impl : public DayCounter::Impl {
           public:
@@ -85,6 +93,14 @@ namespace QuantLib {
                               const Date&,
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void dayCounts(const Date* d1,
+                           const Date* d2,
+                           Date::serial_type* out,
+                           Size n) const;
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* out,
+                               Size n) const;
         };
         class IT_Impl : public DayCounter::Impl {
           public:
@@ -95,6 +111,14 @@ namespace QuantLib {
                               const Date&,
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void dayCounts(const Date* d1,
+                           const Date* d2,
+                           Date::serial_type* out,
+                           Size n) const;
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* out,
+                               Size n) const;
         };
         class GER_Impl : public DayCounter::Impl {
           public:
@@ -106,6 +130,14 @@ namespace QuantLib {
                               const Date&,
                               const Date&) const {
                 return dayCount(d1,d2)/360.0; }
+            void dayCounts(const Date* d1,
+                           const Date* d2,
+                           Date::serial_type* out,
+                           Size n) const;
+            void yearFractions(const Date* d1,
+                               const Date* d2,
+                               Time* out,
+                               Size n) const;
         private:
             bool isLastPeriod_;
         };
@@ -0,0 +1,116 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/schedulecache.hpp>
+
+namespace QuantLib {
+
+    ScheduleCache::ScheduleCache()
+    : maxSize_(10000) {}
+
+    void ScheduleCache::setMaxSize(Size n) {
+        QL_REQUIRE(n > 0, "maximum size must be positive");
+        maxSize_ = n;
+        while (data_.size() > maxSize_) {
+            data_.erase(order_.front());
+            order_.pop_front();
+        }
+    }
+
+    void ScheduleCache::clear() {
+        data_.clear();
+        order_.clear();
+    }
+
+    bool ScheduleCache::Key::operator<(const Key& k) const {
+        if (effectiveDate != k.effectiveDate)
+            return effectiveDate < k.effectiveDate;
+        if (terminationDate != k.terminationDate)
+            return terminationDate < k.terminationDate;
+        if (tenorLength != k.tenorLength)
+            return tenorLength < k.tenorLength;
+        if (tenorUnits != k.tenorUnits)
+            return tenorUnits < k.tenorUnits;
+        if (convention != k.convention)
+            return convention < k.convention;
+        if (terminationDateConvention != k.terminationDateConvention)
+            return terminationDateConvention < k.terminationDateConvention;
+        if (rule != k.rule)
+            return rule < k.rule;
+        if (endOfMonth != k.endOfMonth)
+            return endOfMonth < k.endOfMonth;
+        if (firstDate != k.firstDate)
+            return firstDate < k.firstDate;
+        if (nextToLastDate != k.nextToLastDate)
+            return nextToLastDate < k.nextToLastDate;
+        return calendar < k.calendar;
+    }
+
+    Schedule ScheduleCache::schedule(
+                               const Date& effectiveDate,
+                               const Date& terminationDate,
+                               const Period& tenor,
+                               const Calendar& calendar,
+                               BusinessDayConvention convention,
+                               BusinessDayConvention terminationDateConvention,
+                               DateGeneration::Rule rule,
+                               bool endOfMonth,
+                               const Date& firstDate,
+                               const Date& nextToLastDate) {
+        if (effectiveDate == Date())
+            return Schedule(effectiveDate, terminationDate, tenor, calendar,
+                            convention, terminationDateConvention, rule,
+                            endOfMonth, firstDate, nextToLastDate);
+
+        Key key;
+        key.effectiveDate = effectiveDate;
+        key.terminationDate = terminationDate;
+        key.tenorLength = tenor.length();
+        key.tenorUnits = tenor.units();
+        key.calendar = calendar.empty() ? std::string() : calendar.name();
+        key.convention = convention;
+        key.terminationDateConvention = terminationDateConvention;
+        key.rule = rule;
+        key.endOfMonth = endOfMonth;
+        key.firstDate = firstDate;
+        key.nextToLastDate = nextToLastDate;
+
+        const unsigned long version = calendar.businessDaysVersion();
+
+        map_type::iterator i = data_.find(key);
+        if (i != data_.end() && i->second.second == version)
+            return i->second.first;
+
+        Schedule s(effectiveDate, terminationDate, tenor, calendar,
+                   convention, terminationDateConvention, rule,
+                   endOfMonth, firstDate, nextToLastDate);
+        if (i != data_.end()) {
+            // holidays changed since the schedule was stored
+            i->second = std::make_pair(s, version);
+            return s;
+        }
+        if (data_.size() == maxSize_) {
+            data_.erase(order_.front());
+            order_.pop_front();
+        }
+        order_.push_back(
+            data_.insert(std::make_pair(key, std::make_pair(s, version)))
+            .first);
+        return s;
+    }
+
+}
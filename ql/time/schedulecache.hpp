@@ -0,0 +1,99 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief global repository of generated schedules
+*/
+
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/time/schedule.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <map>
+#include <deque>
+
+namespace QuantLib {
+
+    //! global repository of generated schedules
+    /*! Schedules are stored by their generation parameters; asking
+        twice for the same parameters returns schedules sharing the
+        same date vectors, so that large portfolios of trades with
+        the same conventions only generate and store their dates once.
+        Copies of the returned schedules (e.g., the ones stored by
+        leg builders) share the dates as well.
+
+        Calendars are identified by name.  Schedules with a null
+        effective date are not stored, since their dates depend on
+        the evaluation date.  Stored schedules are regenerated when
+        holidays are added to or removed from their calendar.
+
+        At most maxSize() schedules are stored; when the limit is
+        reached, the ones stored first are discarded.  Schedules
+        previously returned stay valid.
+    */
+    class ScheduleCache : public Singleton<ScheduleCache> {
+        friend class Singleton<ScheduleCache>;
+      private:
+        ScheduleCache();
+      public:
+        //! returns the schedule for the given parameters
+        /*! The schedule is generated and stored unless already
+            available.  Arguments are the same as for the rule-based
+            Schedule constructor.
+        */
+        Schedule schedule(const Date& effectiveDate,
+                          const Date& terminationDate,
+                          const Period& tenor,
+                          const Calendar& calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth,
+                          const Date& firstDate = Date(),
+                          const Date& nextToLastDate = Date());
+        //! returns the number of stored schedules
+        Size size() const { return data_.size(); }
+        //! returns the maximum number of stored schedules
+        Size maxSize() const { return maxSize_; }
+        //! sets the maximum number of stored schedules
+        void setMaxSize(Size n);
+        //! clears all stored schedules
+        void clear();
+      private:
+        struct Key {
+            Date effectiveDate, terminationDate;
+            Integer tenorLength;
+            TimeUnit tenorUnits;
+            std::string calendar;
+            BusinessDayConvention convention, terminationDateConvention;
+            DateGeneration::Rule rule;
+            bool endOfMonth;
+            Date firstDate, nextToLastDate;
+            bool operator<(const Key&) const;
+        };
+        // stored with the version of the calendar they were built for
+        typedef std::map<Key, std::pair<Schedule, unsigned long> > map_type;
+        map_type data_;
+        std::deque<map_type::iterator> order_;
+        Size maxSize_;
+    };
+
+}
+
+
+#endif
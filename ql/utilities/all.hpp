@@ -5,6 +5,7 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/dataparsers.hpp>
 #include <ql/utilities/disposable.hpp>
+#include <ql/utilities/marketdatasnapshot.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/utilities/null_deleter.hpp>
 #include <ql/utilities/observablevalue.hpp>
@@ -0,0 +1,371 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/marketdatasnapshot.hpp>
+#include <ql/indexes/indexmanager.hpp>
+#include <ql/utilities/null.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using boost::algorithm::to_upper_copy;
+
+namespace QuantLib {
+
+    namespace {
+
+        /* File layout (native byte order, offsets from the start of
+           the file):
+
+           header:      char magic[8], uint64 nSeries, uint64 nQuotes
+           series:      nSeries x { uint64 nameOffset, nameLength,
+                                    dataOffset, size }
+           quotes:      nQuotes x { uint64 nameOffset, nameLength;
+                                    double value }
+           names:       concatenated characters, padded to 8 bytes
+           series data: for each series, size int32 date serial
+                        numbers (padded to 8 bytes) followed by size
+                        double values
+        */
+
+        const char magic[8] = { 'Q','L','S','N','A','P','0','1' };
+
+        struct Header {
+            char magic[8];
+            boost::uint64_t nSeries, nQuotes;
+        };
+
+        struct SeriesEntry {
+            boost::uint64_t nameOffset, nameLength, dataOffset, size;
+        };
+
+        struct QuoteEntry {
+            boost::uint64_t nameOffset, nameLength;
+            double value;
+        };
+
+        boost::uint64_t padded(boost::uint64_t n) {
+            return (n + 7) & ~boost::uint64_t(7);
+        }
+
+        void checkName(boost::uint64_t offset, boost::uint64_t length,
+                       boost::uint64_t size, const std::string& filename) {
+            QL_REQUIRE(offset <= size && length <= size - offset,
+                       filename << " is truncated");
+        }
+
+        void writePadding(std::ofstream& out, boost::uint64_t n) {
+            static const char zeros[8] = {};
+            out.write(zeros, std::streamsize(padded(n) - n));
+        }
+
+    }
+
+    class MarketDataSnapshot::Data {
+      public:
+        explicit Data(const std::string& filename)
+        : file_(filename.c_str(), boost::interprocess::read_only),
+          region_(file_, boost::interprocess::read_only) {
+            const char* base = static_cast<const char*>(region_.get_address());
+            std::size_t size = region_.get_size();
+
+            QL_REQUIRE(size >= sizeof(Header)
+                       && std::memcmp(base, magic, sizeof(magic)) == 0,
+                       filename << " is not a market-data snapshot");
+            // the header values are not trusted; they're compared with
+            // the remaining size instead of being added, which might
+            // overflow
+            const Header* header = reinterpret_cast<const Header*>(base);
+            boost::uint64_t remaining = size - sizeof(Header);
+            QL_REQUIRE(header->nSeries <= remaining / sizeof(SeriesEntry),
+                       filename << " is truncated");
+            remaining -= header->nSeries * sizeof(SeriesEntry);
+            QL_REQUIRE(header->nQuotes <= remaining / sizeof(QuoteEntry),
+                       filename << " is truncated");
+
+            const SeriesEntry* series =
+                reinterpret_cast<const SeriesEntry*>(base + sizeof(Header));
+            for (Size i=0; i<header->nSeries; ++i) {
+                const SeriesEntry& e = series[i];
+                checkName(e.nameOffset, e.nameLength, size, filename);
+                QL_REQUIRE(e.dataOffset % 8 == 0,
+                           filename << " is corrupted");
+                QL_REQUIRE(e.dataOffset <= size,
+                           filename << " is truncated");
+                // each fixing takes at least 12 bytes, which also
+                // bounds the sizes computed below
+                const boost::uint64_t available = size - e.dataOffset;
+                QL_REQUIRE(e.size <= available / (sizeof(boost::int32_t)
+                                                  + sizeof(double))
+                           && padded(e.size*sizeof(boost::int32_t))
+                              + e.size*sizeof(double) <= available,
+                           filename << " is truncated");
+                Fixings f;
+                f.dates_ = reinterpret_cast<const boost::int32_t*>(
+                                                        base + e.dataOffset);
+                f.values_ = reinterpret_cast<const double*>(
+                    base + e.dataOffset
+                         + padded(e.size*sizeof(boost::int32_t)));
+                f.size_ = Size(e.size);
+                fixings[std::string(base + e.nameOffset,
+                                    Size(e.nameLength))] = f;
+            }
+
+            const QuoteEntry* quoteEntries =
+                reinterpret_cast<const QuoteEntry*>(
+                           base + sizeof(Header)
+                                + header->nSeries * sizeof(SeriesEntry));
+            for (Size i=0; i<header->nQuotes; ++i) {
+                const QuoteEntry& e = quoteEntries[i];
+                checkName(e.nameOffset, e.nameLength, size, filename);
+                quotes[std::string(base + e.nameOffset,
+                                   Size(e.nameLength))] = e.value;
+            }
+        }
+
+        // the stored Fixings don't hold a reference to the data, to
+        // avoid a cycle; it is added when they're returned
+        std::map<std::string, Fixings> fixings;
+        std::map<std::string, Real> quotes;
+      private:
+        boost::interprocess::file_mapping file_;
+        boost::interprocess::mapped_region region_;
+    };
+
+
+    MarketDataSnapshot::Fixings::Fixings()
+    : dates_(0), values_(0), size_(0) {}
+
+    Date MarketDataSnapshot::Fixings::firstDate() const {
+        QL_REQUIRE(size_ > 0, "empty fixing history");
+        return Date(dates_[0]);
+    }
+
+    Date MarketDataSnapshot::Fixings::lastDate() const {
+        QL_REQUIRE(size_ > 0, "empty fixing history");
+        return Date(dates_[size_-1]);
+    }
+
+    Date MarketDataSnapshot::Fixings::date(Size i) const {
+        QL_REQUIRE(i < size_,
+                   "index " << i << " out of range [0, " << size_ << ")");
+        return Date(dates_[i]);
+    }
+
+    Real MarketDataSnapshot::Fixings::value(Size i) const {
+        QL_REQUIRE(i < size_,
+                   "index " << i << " out of range [0, " << size_ << ")");
+        return values_[i];
+    }
+
+    Real MarketDataSnapshot::Fixings::operator[](const Date& d) const {
+        const boost::int32_t serial = boost::int32_t(d.serialNumber());
+        const boost::int32_t* i =
+            std::lower_bound(dates_, dates_ + size_, serial);
+        if (i != dates_ + size_ && *i == serial)
+            return values_[i - dates_];
+        else
+            return Null<Real>();
+    }
+
+    TimeSeries<Real> MarketDataSnapshot::Fixings::timeSeries() const {
+        TimeSeries<Real> result;
+        for (Size i=0; i<size_; ++i)
+            result[Date(dates_[i])] = values_[i];
+        return result;
+    }
+
+
+    MarketDataSnapshot::MarketDataSnapshot(const std::string& filename)
+    : data_(new Data(filename)) {}
+
+    std::vector<std::string> MarketDataSnapshot::fixingNames() const {
+        std::vector<std::string> names;
+        names.reserve(data_->fixings.size());
+        for (std::map<std::string, Fixings>::const_iterator i =
+                 data_->fixings.begin(); i != data_->fixings.end(); ++i)
+            names.push_back(i->first);
+        return names;
+    }
+
+    bool MarketDataSnapshot::hasFixings(const std::string& name) const {
+        return data_->fixings.find(to_upper_copy(name))
+            != data_->fixings.end();
+    }
+
+    MarketDataSnapshot::Fixings
+    MarketDataSnapshot::fixings(const std::string& name) const {
+        std::map<std::string, Fixings>::const_iterator i =
+            data_->fixings.find(to_upper_copy(name));
+        QL_REQUIRE(i != data_->fixings.end(),
+                   "no fixings for " << name << " in snapshot");
+        Fixings result = i->second;
+        result.data_ = data_;
+        return result;
+    }
+
+    void MarketDataSnapshot::loadFixings() const {
+        for (std::map<std::string, Fixings>::const_iterator i =
+                 data_->fixings.begin(); i != data_->fixings.end(); ++i) {
+            const Fixings& f = i->second;
+            std::vector<Date> dates(f.size());
+            for (Size j=0; j<f.size(); ++j)
+                dates[j] = Date(f.dates_[j]);
+            IndexManager::instance().addFixings(i->first,
+                                                dates.begin(), dates.end(),
+                                                f.values_);
+        }
+    }
+
+    std::vector<std::string> MarketDataSnapshot::quoteNames() const {
+        std::vector<std::string> names;
+        names.reserve(data_->quotes.size());
+        for (std::map<std::string, Real>::const_iterator i =
+                 data_->quotes.begin(); i != data_->quotes.end(); ++i)
+            names.push_back(i->first);
+        return names;
+    }
+
+    bool MarketDataSnapshot::hasQuote(const std::string& name) const {
+        return data_->quotes.find(name) != data_->quotes.end();
+    }
+
+    Real MarketDataSnapshot::quote(const std::string& name) const {
+        std::map<std::string, Real>::const_iterator i =
+            data_->quotes.find(name);
+        QL_REQUIRE(i != data_->quotes.end(),
+                   "no quote " << name << " in snapshot");
+        return i->second;
+    }
+
+
+    void MarketDataSnapshot::save(
+                 const std::string& filename,
+                 const std::map<std::string, TimeSeries<Real> >& fixings,
+                 const std::map<std::string, Real>& quotes) {
+
+        typedef std::map<std::string, TimeSeries<Real> >::const_iterator
+                                                               series_iterator;
+        typedef std::map<std::string, Real>::const_iterator quote_iterator;
+
+        // names are upper-cased as in the IndexManager; this might
+        // cause clashes, which we check for.
+        std::map<std::string, const TimeSeries<Real>*> series;
+        for (series_iterator i = fixings.begin(); i != fixings.end(); ++i) {
+            const std::string name = to_upper_copy(i->first);
+            QL_REQUIRE(series.find(name) == series.end(),
+                       "duplicated fixing history for " << name);
+            series[name] = &(i->second);
+        }
+
+        Header header;
+        std::memcpy(header.magic, magic, sizeof(magic));
+        header.nSeries = series.size();
+        header.nQuotes = quotes.size();
+
+        // lay out names
+        boost::uint64_t offset = sizeof(Header)
+                               + header.nSeries * sizeof(SeriesEntry)
+                               + header.nQuotes * sizeof(QuoteEntry);
+        std::vector<SeriesEntry> seriesEntries;
+        seriesEntries.reserve(series.size());
+        for (std::map<std::string, const TimeSeries<Real>*>::const_iterator
+                 i = series.begin(); i != series.end(); ++i) {
+            SeriesEntry e;
+            e.nameOffset = offset;
+            e.nameLength = i->first.size();
+            e.size = i->second->size();
+            offset += e.nameLength;
+            seriesEntries.push_back(e);
+        }
+        std::vector<QuoteEntry> quoteEntries;
+        quoteEntries.reserve(quotes.size());
+        for (quote_iterator i = quotes.begin(); i != quotes.end(); ++i) {
+            QuoteEntry e;
+            e.nameOffset = offset;
+            e.nameLength = i->first.size();
+            e.value = i->second;
+            offset += e.nameLength;
+            quoteEntries.push_back(e);
+        }
+        const boost::uint64_t namesEnd = offset;
+        offset = padded(offset);
+
+        // lay out series data
+        for (Size i=0; i<seriesEntries.size(); ++i) {
+            SeriesEntry& e = seriesEntries[i];
+            e.dataOffset = offset;
+            offset += padded(e.size*sizeof(boost::int32_t))
+                    + e.size*sizeof(double);
+        }
+
+        std::ofstream out(filename.c_str(),
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+        QL_REQUIRE(out, "cannot open " << filename << " for writing");
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        if (!seriesEntries.empty())
+            out.write(reinterpret_cast<const char*>(&seriesEntries[0]),
+                      seriesEntries.size()*sizeof(SeriesEntry));
+        if (!quoteEntries.empty())
+            out.write(reinterpret_cast<const char*>(&quoteEntries[0]),
+                      quoteEntries.size()*sizeof(QuoteEntry));
+        for (std::map<std::string, const TimeSeries<Real>*>::const_iterator
+                 i = series.begin(); i != series.end(); ++i)
+            out.write(i->first.data(), std::streamsize(i->first.size()));
+        for (quote_iterator i = quotes.begin(); i != quotes.end(); ++i)
+            out.write(i->first.data(), std::streamsize(i->first.size()));
+        writePadding(out, namesEnd);
+
+        std::vector<boost::int32_t> serials;
+        std::vector<double> values;
+        for (std::map<std::string, const TimeSeries<Real>*>::const_iterator
+                 i = series.begin(); i != series.end(); ++i) {
+            const TimeSeries<Real>& ts = *(i->second);
+            serials.clear();
+            values.clear();
+            for (TimeSeries<Real>::const_iterator j = ts.cbegin();
+                 j != ts.cend(); ++j) {
+                serials.push_back(boost::int32_t(j->first.serialNumber()));
+                values.push_back(j->second);
+            }
+            if (!serials.empty()) {
+                out.write(reinterpret_cast<const char*>(&serials[0]),
+                          serials.size()*sizeof(boost::int32_t));
+                writePadding(out, serials.size()*sizeof(boost::int32_t));
+                out.write(reinterpret_cast<const char*>(&values[0]),
+                          values.size()*sizeof(double));
+            }
+        }
+
+        QL_REQUIRE(out, "error while writing " << filename);
+    }
+
+    void MarketDataSnapshot::saveIndexManager(
+                                  const std::string& filename,
+                                  const std::map<std::string, Real>& quotes) {
+        std::map<std::string, TimeSeries<Real> > fixings;
+        std::vector<std::string> names = IndexManager::instance().histories();
+        for (Size i=0; i<names.size(); ++i)
+            fixings[names[i]] = IndexManager::instance().getHistory(names[i]);
+        save(filename, fixings, quotes);
+    }
+
+}
@@ -0,0 +1,118 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file marketdatasnapshot.hpp
+    \brief memory-mapped binary store of fixings and quotes
+*/
+
+#ifndef quantlib_market_data_snapshot_hpp
+#define quantlib_market_data_snapshot_hpp
+
+#include <ql/timeseries.hpp>
+#include <boost/cstdint.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    //! memory-mapped binary store of fixings and quotes
+    /*! A snapshot file contains the fixing histories of a number of
+        indexes, keyed by their upper-case name as in IndexManager,
+        and a number of named quote values.  The file is mapped
+        read-only in memory when opened; therefore, processes on the
+        same host reading the same snapshot share a single physical
+        copy of the data, and opening it doesn't require any parsing.
+
+        Fixings can be read directly from the mapped file through
+        the Fixings view; this is the only way to use the shared
+        pages.  Indexes read their fixings from the IndexManager,
+        which stores its own copy of each history; loadFixings()
+        is only a fast way to fill it and takes memory in each
+        process.
+
+        \warning The file uses the native byte order and is not
+                 meant to be exchanged between different platforms.
+    */
+    class MarketDataSnapshot {
+      private:
+        class Data;
+      public:
+        //! read-only view of a fixing history in a snapshot
+        /*! The view keeps the snapshot mapped for as long as it
+            exists.  Dates are stored in increasing order, and lookup
+            is performed by bisection.
+        */
+        class Fixings {
+          public:
+            Fixings();
+            Size size() const { return size_; }
+            bool empty() const { return size_ == 0; }
+            Date firstDate() const;
+            Date lastDate() const;
+            Date date(Size i) const;
+            Real value(Size i) const;
+            //! returns the fixing at the given date, or null if missing
+            Real operator[](const Date& d) const;
+            //! returns a copy of the history
+            TimeSeries<Real> timeSeries() const;
+          private:
+            friend class MarketDataSnapshot;
+            ext::shared_ptr<Data> data_;
+            const boost::int32_t* dates_;
+            const double* values_;
+            Size size_;
+        };
+
+        //! maps the given snapshot file
+        explicit MarketDataSnapshot(const std::string& filename);
+
+        //! \name Fixings
+        //@{
+        std::vector<std::string> fixingNames() const;
+        bool hasFixings(const std::string& name) const;
+        Fixings fixings(const std::string& name) const;
+        //! copies all fixing histories into the IndexManager
+        /*! The copies are not shared among processes. */
+        void loadFixings() const;
+        //@}
+
+        //! \name Quotes
+        //@{
+        std::vector<std::string> quoteNames() const;
+        bool hasQuote(const std::string& name) const;
+        Real quote(const std::string& name) const;
+        //@}
+
+        //! writes a snapshot file
+        static void save(const std::string& filename,
+                         const std::map<std::string, TimeSeries<Real> >&
+                                                                   fixings,
+                         const std::map<std::string, Real>& quotes =
+                                              std::map<std::string, Real>());
+        //! writes the fixings stored in the IndexManager and the given quotes
+        static void saveIndexManager(const std::string& filename,
+                                     const std::map<std::string, Real>&
+                                         quotes = std::map<std::string, Real>());
+      private:
+        ext::shared_ptr<Data> data_;
+    };
+
+}
+
+
+#endif
@@ -23,6 +23,8 @@
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/randomnumbers/inversecumulativersg.hpp>
+#include <ql/math/randomnumbers/batchbrownianbridgersg.hpp>
+#include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -271,10 +273,87 @@ void BrownianBridgeTest::testPathGeneration() {
     }
 }
 
+void BrownianBridgeTest::testBatchTransform() {
+    BOOST_TEST_MESSAGE("Testing Brownian-bridge transform of path blocks...");
+
+    std::vector<Time> times;
+    times.push_back(0.1);
+    times.push_back(0.2);
+    times.push_back(0.5);
+    times.push_back(1.0);
+    times.push_back(2.0);
+    times.push_back(3.0);
+    times.push_back(5.0);
+    times.push_back(7.0);
+    times.push_back(10.0);
+
+    Size N = times.size();
+
+    // not a multiple of the block size, so that the last block
+    // is only partially used
+    Size samples = 1000;
+    Size blockSize = 64;
+    unsigned long seed = 42;
+
+    typedef InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> GSG;
+    GSG gsg(SobolRsg(N, seed));
+
+    BrownianBridge bridge(times);
+    GSG generator1(gsg);
+    BatchBrownianBridgeRsg<GSG> generator2(gsg, bridge, blockSize);
+
+    std::vector<Real> expected(N);
+    Real tolerance = 1.0e-14;
+
+    for (Size i=0; i<samples; ++i) {
+        const std::vector<Real>& sample = generator1.nextSequence().value;
+        bridge.transform(sample.begin(), sample.end(), expected.begin());
+
+        const std::vector<Real>& calculated =
+            generator2.nextSequence().value;
+
+        Real error = maxDiff(calculated.begin(), calculated.end(),
+                             expected.begin());
+        if (error > tolerance)
+            BOOST_FAIL("failed to reproduce single-path bridge"
+                       << "\n    sample:    " << i
+                       << "\n    max error: " << error);
+    }
+
+    // same for the market-model generator
+    Size factors = 3;
+    SobolBrownianGenerator mmGenerator1(factors, N,
+                                        SobolBrownianGenerator::Diagonal,
+                                        seed);
+    SobolBrownianGenerator mmGenerator2(factors, N,
+                                        SobolBrownianGenerator::Diagonal,
+                                        seed, SobolRsg::Jaeckel,
+                                        blockSize);
+
+    std::vector<Real> step1(factors), step2(factors);
+    for (Size i=0; i<samples; ++i) {
+        mmGenerator1.nextPath();
+        mmGenerator2.nextPath();
+        for (Size j=0; j<N; ++j) {
+            mmGenerator1.nextStep(step1);
+            mmGenerator2.nextStep(step2);
+            Real error = maxDiff(step2.begin(), step2.end(),
+                                 step1.begin());
+            if (error > tolerance)
+                BOOST_FAIL("failed to reproduce single-path "
+                           "market-model Brownian generator"
+                           << "\n    sample:    " << i
+                           << "\n    step:      " << j
+                           << "\n    max error: " << error);
+        }
+    }
+}
+
 test_suite* BrownianBridgeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Brownian bridge tests");
     suite->add(QUANTLIB_TEST_CASE(&BrownianBridgeTest::testVariates));
     suite->add(QUANTLIB_TEST_CASE(&BrownianBridgeTest::testPathGeneration));
+    suite->add(QUANTLIB_TEST_CASE(&BrownianBridgeTest::testBatchTransform));
     return suite;
 }
 
@@ -43,6 +43,26 @@
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
+namespace {
+
+    // removes the holiday even when the test fails, so that it
+    // doesn't leak into the shared calendar implementation
+    class TemporaryHoliday {
+      public:
+        TemporaryHoliday(const Calendar& calendar, const Date& d)
+        : calendar_(calendar), date_(d) {
+            calendar_.addHoliday(date_);
+        }
+        ~TemporaryHoliday() {
+            calendar_.removeHoliday(date_);
+        }
+      private:
+        Calendar calendar_;
+        Date date_;
+    };
+
+}
+
 void CalendarTest::testModifiedCalendars() {
 
     BOOST_TEST_MESSAGE("Testing calendar modification...");
@@ -181,6 +201,30 @@ void CalendarTest::testJointCalendars() {
                        << "    and its components");
 
     }
+
+    // changes to the components must be reflected
+    Date christmas(25, December, 2015);
+    QL_REQUIRE(c12h.isHoliday(christmas) && c12b.isHoliday(christmas),
+               "wrong assumption---correct the test");
+    c1.removeHoliday(christmas);
+    bool joinedHolidays = c12h.isBusinessDay(christmas),
+         joinedBusinessDays = c12b.isBusinessDay(christmas);
+    c2.removeHoliday(christmas);
+    bool bothRemoved = c12h.isBusinessDay(christmas);
+    // restore the original calendars
+    c1.addHoliday(christmas);
+    c2.addHoliday(christmas);
+    if (joinedHolidays)
+        BOOST_FAIL(christmas << " is a business day for " << c12h.name()
+                   << " after being removed from " << c1.name() << " only");
+    if (!joinedBusinessDays)
+        BOOST_FAIL(christmas << " is a holiday for " << c12b.name()
+                   << " after being removed from " << c1.name());
+    if (!bothRemoved)
+        BOOST_FAIL(christmas << " is a holiday for " << c12h.name()
+                   << " after being removed from both components");
+    if (c12h.isBusinessDay(christmas) || c12b.isBusinessDay(christmas))
+        BOOST_FAIL(christmas << " not restored as a holiday");
 }
 
 void CalendarTest::testUSSettlement() {
@@ -2102,6 +2146,112 @@ void CalendarTest::testBespokeCalendars() {
 
 }
 
+void CalendarTest::testAdvanceByBusinessDays() {
+
+    BOOST_TEST_MESSAGE("Testing advancing by business days...");
+
+    Calendar uk = UnitedKingdom();
+    JointCalendar joint(uk, Japan());
+    std::vector<Calendar> calendars;
+    calendars.push_back(TARGET());
+    calendars.push_back(UnitedStates(UnitedStates::NYSE));
+    calendars.push_back(China(China::SSE));
+    calendars.push_back(joint);
+
+    // changes to a component must be seen by the joint calendar
+    Date d(4, March, 2015);
+    QL_REQUIRE(joint.isBusinessDay(d), "wrong assumption---correct the test");
+    TemporaryHoliday holiday(uk, d);
+    if (joint.isBusinessDay(d))
+        BOOST_FAIL(d << " still a business day for joint calendar");
+
+    Integer steps[] = { 1, 2, 5, 22, 100, 253, 1000 };
+    for (Size i=0; i<calendars.size(); ++i) {
+        const Calendar& c = calendars[i];
+        for (Date start(28, December, 2013); start < Date(10, January, 2015);
+             start += 17) {
+            for (Size j=0; j<LENGTH(steps); ++j) {
+                Integer n = steps[j];
+
+                // day-by-day reference
+                Date forward = start, backward = start;
+                for (Integer k=0; k<n; ++k) {
+                    do { ++forward; } while (c.isHoliday(forward));
+                    do { --backward; } while (c.isHoliday(backward));
+                }
+
+                Date calculated = c.advance(start, n, Days);
+                if (calculated != forward)
+                    BOOST_FAIL("advancing " << start << " by " << n
+                               << " business days in " << c.name()
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << forward);
+                calculated = c.advance(start, -n, Days);
+                if (calculated != backward)
+                    BOOST_FAIL("advancing " << start << " by " << -n
+                               << " business days in " << c.name()
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << backward);
+
+                Date::serial_type count = 0;
+                for (Date d1 = start; d1 <= forward; ++d1)
+                    if (c.isBusinessDay(d1))
+                        ++count;
+                Date::serial_type calculatedCount =
+                    c.businessDaysBetween(start, forward, true, true);
+                if (calculatedCount != count)
+                    BOOST_FAIL("business days between " << start
+                               << " and " << forward << " in " << c.name()
+                               << "\n    calculated: " << calculatedCount
+                               << "\n    expected:   " << count);
+            }
+        }
+    }
+}
+
+void CalendarTest::testConcurrentQueries() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent calendar queries...");
+
+    // a new calendar, so that its business days are built by the
+    // concurrent queries
+    BespokeCalendar c;
+    c.addWeekend(Saturday);
+    c.addWeekend(Sunday);
+
+    const Year firstYear = 1950, lastYear = 2100;
+    std::vector<Date::serial_type> expected(lastYear-firstYear+1, 0);
+    for (Year y=firstYear; y<=lastYear; ++y) {
+        for (Date d(1, January, y); d <= Date(31, December, y); ++d) {
+            if (d.weekday() != Saturday && d.weekday() != Sunday)
+                ++expected[y-firstYear];
+        }
+    }
+
+    std::vector<Date::serial_type> calculated(expected.size(), 0);
+    #pragma omp parallel for
+    for (long i=0; i<(long)expected.size(); ++i) {
+        const Year y = firstYear + Year(i);
+        calculated[i] = c.businessDaysBetween(Date(1, January, y),
+                                              Date(31, December, y),
+                                              true, true);
+    }
+
+    for (Size i=0; i<expected.size(); ++i) {
+        if (calculated[i] != expected[i])
+            BOOST_ERROR("wrong business days in " << firstYear + Year(i)
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+
+    // a calendar without implementation must throw
+    BOOST_CHECK_THROW(Calendar().businessDaysBetween(Date(1, January, 2020),
+                                                     Date(1, March, 2020)),
+                      Error);
+    BOOST_CHECK_THROW(Calendar().advance(Date(1, January, 2020), 5, Days),
+                      Error);
+}
+
 void CalendarTest::testIntradayAddHolidays() {
 #ifdef QL_HIGH_RESOLUTION_DATE
     BOOST_TEST_MESSAGE("Testing addHolidays with enable-intraday...");
@@ -2229,6 +2379,8 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testAdvanceByBusinessDays));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testConcurrentQueries));
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testIntradayAddHolidays));
 
@@ -60,6 +60,8 @@ class CalendarTest {
 
     static void testEndOfMonth();
     static void testBusinessDaysBetween();
+    static void testAdvanceByBusinessDays();
+    static void testConcurrentQueries();
 
     static void testIntradayAddHolidays();
 
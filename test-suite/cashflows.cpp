@@ -25,13 +25,16 @@
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/experimental/coupons/proxyibor.hpp>
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/time/schedule.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/settings.hpp>
+#include <iomanip>
 
 
 using namespace QuantLib;
@@ -420,6 +423,209 @@ void CashFlowsTest::testPartialScheduleLegConstruction() {
     BOOST_CHECK_EQUAL(lastCpnF3->referencePeriodEnd(), Date(30, Sep, 2020));
 }
 
+void CashFlowsTest::testFixingNotifications() {
+    BOOST_TEST_MESSAGE("Testing notifications of ibor coupons on new fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(7, April, 2010);
+    Settings::instance().evaluationDate() = today;
+
+    RelinkableHandle<YieldTermStructure> forecastCurve(
+                                      flatRate(today, 0.03, Actual360()));
+    ext::shared_ptr<IborIndex> index(new USDLibor(6*Months, forecastCurve));
+    index->enablePerFixingNotifications();
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-1*Years).to(today+3*Years)
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Following)
+        .backwards();
+    Leg leg = IborLeg(schedule, index).withNotionals(100.0);
+
+    std::vector<ext::shared_ptr<Flag> > flags(leg.size());
+    std::vector<Date> fixingDates(leg.size());
+    for (Size i=0; i<leg.size(); ++i) {
+        ext::shared_ptr<FloatingRateCoupon> c =
+            ext::dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+        fixingDates[i] = c->fixingDate();
+        flags[i] = ext::make_shared<Flag>();
+        flags[i]->registerWith(leg[i]);
+    }
+
+    IndexManager::instance().resetFixingNotificationCounters();
+
+    // a fixing no coupon depends upon
+    Date otherDate = index->fixingCalendar().adjust(fixingDates[0] + 7);
+    index->addFixing(otherDate, 0.01);
+    for (Size i=0; i<leg.size(); ++i) {
+        if (flags[i]->isUp())
+            BOOST_ERROR("coupon " << i << " notified of fixing at "
+                        << otherDate);
+    }
+    if (IndexManager::instance().fixingNotifications() != 0
+        || IndexManager::instance().avoidedFixingNotifications()
+                                                          != leg.size())
+        BOOST_ERROR("unexpected notification counters: "
+                    << IndexManager::instance().fixingNotifications()
+                    << " notified, "
+                    << IndexManager::instance().avoidedFixingNotifications()
+                    << " avoided");
+
+    // the fixing of the first coupon
+    index->addFixing(fixingDates[0], 0.02);
+    if (!flags[0]->isUp())
+        BOOST_ERROR("coupon not notified of its own fixing");
+    for (Size i=1; i<leg.size(); ++i) {
+        if (flags[i]->isUp())
+            BOOST_ERROR("coupon " << i << " notified of fixing at "
+                        << fixingDates[0]);
+    }
+    if (IndexManager::instance().fixingNotifications() != 1)
+        BOOST_ERROR("unexpected notification counter: "
+                    << IndexManager::instance().fixingNotifications()
+                    << " notified");
+    flags[0]->lower();
+
+    // all coupons still depend on the forecast curve...
+    forecastCurve.linkTo(flatRate(today, 0.04, Actual360()));
+    for (Size i=0; i<leg.size(); ++i) {
+        if (!flags[i]->isUp())
+            BOOST_ERROR("coupon " << i << " not notified of curve change");
+        flags[i]->lower();
+    }
+
+    // ...and on the evaluation date
+    Settings::instance().evaluationDate() = today + 1;
+    for (Size i=0; i<leg.size(); ++i) {
+        if (!flags[i]->isUp())
+            BOOST_ERROR("coupon " << i
+                        << " not notified of evaluation-date change");
+    }
+
+    // notifiers are dropped together with the coupons observing them
+    flags.clear();
+    leg.clear();
+    IndexManager::instance().resetFixingNotificationCounters();
+    index->addFixing(index->fixingCalendar().advance(otherDate, 1, Days),
+                     0.01);
+    if (IndexManager::instance().fixingNotifications() != 0
+        || IndexManager::instance().avoidedFixingNotifications() != 0)
+        BOOST_ERROR("unexpected notification counters "
+                    "after destroying the coupons: "
+                    << IndexManager::instance().fixingNotifications()
+                    << " notified, "
+                    << IndexManager::instance().avoidedFixingNotifications()
+                    << " avoided");
+}
+
+void CashFlowsTest::testProxyIborNotifications() {
+    BOOST_TEST_MESSAGE("Testing notifications of coupons on proxy ibor...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(7, April, 2010);
+    Settings::instance().evaluationDate() = today;
+
+    RelinkableHandle<YieldTermStructure> forecastCurve(
+                                      flatRate(today, 0.03, Actual360()));
+    ext::shared_ptr<IborIndex> underlying(
+                                   new USDLibor(6*Months, forecastCurve));
+    underlying->enablePerFixingNotifications();
+
+    // the proxy has no forwarding curve of its own and depends on the
+    // underlying index
+    ext::shared_ptr<IborIndex> proxy(
+        new ProxyIbor("proxy", 6*Months, 2, USDCurrency(), TARGET(),
+                      ModifiedFollowing, false, Actual360(),
+                      Handle<Quote>(ext::make_shared<SimpleQuote>(1.0)),
+                      underlying,
+                      Handle<Quote>(ext::make_shared<SimpleQuote>(1.0))));
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-1*Years).to(today+3*Years)
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Following)
+        .backwards();
+    Leg leg = IborLeg(schedule, proxy).withNotionals(100.0);
+
+    std::vector<ext::shared_ptr<Flag> > flags(leg.size());
+    for (Size i=0; i<leg.size(); ++i) {
+        flags[i] = ext::make_shared<Flag>();
+        flags[i]->registerWith(leg[i]);
+    }
+
+    forecastCurve.linkTo(flatRate(today, 0.04, Actual360()));
+    for (Size i=0; i<leg.size(); ++i) {
+        if (!flags[i]->isUp())
+            BOOST_ERROR("coupon " << i
+                        << " not notified of underlying curve change");
+        flags[i]->lower();
+    }
+
+    underlying->addFixing(underlying->fixingCalendar().adjust(today-7),
+                          0.02);
+    for (Size i=0; i<leg.size(); ++i) {
+        if (!flags[i]->isUp())
+            BOOST_ERROR("coupon " << i
+                        << " not notified of underlying fixing");
+    }
+}
+
+void CashFlowsTest::testLegFixings() {
+    BOOST_TEST_MESSAGE("Testing leg-level calculation of ibor fixings...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(7, April, 2010);
+    Settings::instance().evaluationDate() = today;
+
+    Handle<YieldTermStructure> forecastCurve(
+                                      flatRate(today, 0.03, Actual360()));
+    ext::shared_ptr<IborIndex> index(new USDLibor(3*Months, forecastCurve));
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-6*Months).to(today+10*Years)
+        .withFrequency(Quarterly)
+        .withCalendar(TARGET())
+        .withConvention(Following)
+        .backwards();
+    Leg leg = IborLeg(schedule, index)
+        .withNotionals(100.0)
+        .withSpreads(0.001);
+    leg.push_back(ext::make_shared<SimpleCashFlow>(100.0, schedule.endDate()));
+
+    for (Size i=0; i<leg.size(); ++i) {
+        ext::shared_ptr<FloatingRateCoupon> c =
+            ext::dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+        if (c && c->fixingDate() <= today)
+            index->addFixing(c->fixingDate(), 0.02 + 0.001*i);
+    }
+
+    std::vector<Rate> fixings = iborFixings(leg);
+    if (fixings.size() != leg.size())
+        BOOST_FAIL("wrong number of fixings: " << fixings.size()
+                   << " instead of " << leg.size());
+    for (Size i=0; i<leg.size(); ++i) {
+        ext::shared_ptr<IborCoupon> c =
+            ext::dynamic_pointer_cast<IborCoupon>(leg[i]);
+        Rate expected = c ? c->indexFixing() : Null<Rate>();
+        if (fixings[i] != expected)
+            BOOST_ERROR("fixing mismatch for cash flow " << i << ":"
+                        << std::setprecision(16)
+                        << "\n    leg-level: " << fixings[i]
+                        << "\n    coupon:    " << expected);
+    }
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -434,5 +640,9 @@ test_suite* CashFlowsTest::suite() {
                              &CashFlowsTest::testIrregularLastCouponReferenceDatesAtEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(
                              &CashFlowsTest::testPartialScheduleLegConstruction));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testFixingNotifications));
+    suite->add(QUANTLIB_TEST_CASE(
+                             &CashFlowsTest::testProxyIborNotifications));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testLegFixings));
     return suite;
 }
@@ -31,6 +31,9 @@ class CashFlowsTest {
     static void testIrregularFirstCouponReferenceDatesAtEndOfMonth();
     static void testIrregularLastCouponReferenceDatesAtEndOfMonth();
     static void testPartialScheduleLegConstruction();
+    static void testFixingNotifications();
+    static void testProxyIborNotifications();
+    static void testLegFixings();
     static boost::unit_test_framework::test_suite* suite();
 };
 
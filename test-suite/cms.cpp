@@ -30,6 +30,7 @@
 #include <ql/cashflows/conundrumpricer.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/lineartsrpricer.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/volatility/swaption/swaptionvolmatrix.hpp>
 #include <ql/termstructures/volatility/swaption/swaptionvolcube2.hpp>
@@ -493,10 +494,121 @@ void CmsTest::testParity() {
     }
 }
 
+void CmsTest::testReplicationCaching() {
+
+    BOOST_TEST_MESSAGE("Testing replication caching in CMS-coupon pricers...");
+
+    CommonVars vars;
+
+    std::vector<Handle<SwaptionVolatilityStructure> > swaptionVols;
+    swaptionVols.push_back(vars.atmVol);
+    swaptionVols.push_back(vars.SabrVolCube2);
+
+    shared_ptr<SwapIndex> swapIndex(new
+        EuriborSwapIsdaFixA(10*Years,
+                            vars.iborIndex->forwardingTermStructure()));
+
+    // coupons sharing their fixing dates, with and without a payment
+    // lag and with different gearings and spreads
+    Date startDate = vars.termStructure->referenceDate() + 1*Years;
+    Schedule schedule = MakeSchedule().from(startDate)
+                                      .to(startDate + 5*Years)
+                                      .withTenor(1*Years)
+                                      .withCalendar(TARGET());
+    Leg leg;
+    for (Size i=1; i<schedule.size(); ++i) {
+        for (Size k=0; k<4; ++k) {
+            Date paymentDate = k < 2 ? schedule[i] : schedule[i] + 6*Months;
+            Real gearing = k % 2 == 0 ? 1.0 : 1.5;
+            Spread spread = k % 2 == 0 ? 0.0 : 0.002;
+            leg.push_back(ext::make_shared<CmsCoupon>(
+                paymentDate, 1.0, schedule[i-1], schedule[i],
+                swapIndex->fixingDays(), swapIndex, gearing, spread,
+                Date(), Date(), vars.iborIndex->dayCounter()));
+        }
+    }
+    leg.push_back(ext::make_shared<SimpleCashFlow>(1.0, schedule.endDate()));
+
+    shared_ptr<SimpleQuote> meanReversionQuote(new SimpleQuote(0.0));
+    Handle<Quote> meanReversion(meanReversionQuote);
+
+    for (Size i=0; i<swaptionVols.size(); ++i) {
+        for (Size j=0; j<vars.yieldCurveModels.size(); ++j) {
+            meanReversionQuote->setValue(0.0);
+            bool linearTsr = j==vars.yieldCurveModels.size()-1;
+            shared_ptr<CmsCouponPricer> pricers[2];
+            for (Size k=0; k<2; ++k) {
+                if (linearTsr)
+                    pricers[k] = ext::make_shared<LinearTsrPricer>(
+                                          swaptionVols[i], meanReversion);
+                else
+                    pricers[k] = ext::make_shared<NumericHaganPricer>(
+                        swaptionVols[i], vars.yieldCurveModels[j],
+                        meanReversion);
+            }
+            shared_ptr<CmsCouponPricer> pricer = pricers[0];
+            shared_ptr<CmsCouponPricer> cachingPricer = pricers[1];
+
+            Real tol = 1.0e-12;
+
+            for (Size m=0; m<2; ++m) {
+                if (m == 1)
+                    meanReversionQuote->setValue(0.02);
+
+                setCouponPricer(leg, pricer);
+                std::vector<Rate> expected(leg.size(), Null<Rate>());
+                for (Size n=0; n<leg.size()-1; ++n)
+                    expected[n] =
+                        ext::dynamic_pointer_cast<CmsCoupon>(leg[n])->rate();
+
+                std::vector<Rate> batch, cached(leg.size(), Null<Rate>());
+                if (linearTsr) {
+                    shared_ptr<LinearTsrPricer> p =
+                        ext::dynamic_pointer_cast<LinearTsrPricer>(
+                                                              cachingPricer);
+                    batch = p->swapletRates(leg);
+                    p->enableReplicationCaching();
+                } else {
+                    shared_ptr<HaganPricer> p =
+                        ext::dynamic_pointer_cast<HaganPricer>(cachingPricer);
+                    batch = p->swapletRates(leg);
+                    p->enableReplicationCaching();
+                }
+                setCouponPricer(leg, cachingPricer);
+                for (Size n=0; n<leg.size()-1; ++n)
+                    cached[n] =
+                        ext::dynamic_pointer_cast<CmsCoupon>(leg[n])->rate();
+
+                if (batch.back() != Null<Rate>())
+                    BOOST_FAIL("rate returned for a non-CMS cash flow");
+                for (Size n=0; n<leg.size()-1; ++n) {
+                    Real batchError = std::fabs(batch[n] - expected[n]);
+                    Real cachedError = std::fabs(cached[n] - expected[n]);
+                    if (batchError > tol || cachedError > tol)
+                        BOOST_FAIL("\nvolatility:          " << i <<
+                                   "\nYieldCurve Model:    "
+                                   << vars.yieldCurveModels[j] <<
+                                   (linearTsr ? " (Linear TSR Model)" : "") <<
+                                   "\nmean reversion:      "
+                                   << meanReversionQuote->value() <<
+                                   "\ncoupon:              " << n <<
+                                   "\nexpected rate:       " << io::rate(expected[n]) <<
+                                   "\nbatch rate:          " << io::rate(batch[n]) <<
+                                   "\ncached rate:         " << io::rate(cached[n]) <<
+                                   "\nbatch error:         " << batchError <<
+                                   "\ncached error:        " << cachedError <<
+                                   "\ntolerance:           " << tol);
+                }
+            }
+        }
+    }
+}
+
 test_suite* CmsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cms tests");
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCmsSwap));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testParity));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testReplicationCaching));
     return suite;
 }
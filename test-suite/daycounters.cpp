@@ -848,6 +848,68 @@ void DayCounterTest::testIntraday() {
 }
 
 
+void DayCounterTest::testBulkCalculations() {
+
+    BOOST_TEST_MESSAGE("Testing bulk day counts and year fractions...");
+
+    DayCounter dayCounters[] = {
+        Actual360(),
+        Actual360(true),
+        Actual365Fixed(),
+        Actual365Fixed(Actual365Fixed::NoLeap),
+        ActualActual(ActualActual::ISDA),
+        ActualActual(ActualActual::ISMA),
+        ActualActual(ActualActual::AFB),
+        Thirty360(Thirty360::BondBasis),
+        Thirty360(Thirty360::EurobondBasis),
+        Thirty360(Thirty360::Italian),
+        Thirty360(Thirty360::German),
+        Thirty360(Thirty360::German, true),
+        SimpleDayCounter(),
+        OneDayCounter()
+    };
+
+    // include month ends, leap days, equal and reversed pairs
+    std::vector<Date> d1, d2;
+    Date start(28, February, 1996);
+    for (Size i=0; i<400; ++i, start += 17) {
+        Date end = start + (i*37) % 1500;
+        d1.push_back(start);
+        d2.push_back(end);
+        d1.push_back(Date::endOfMonth(end));
+        d2.push_back(Date::endOfMonth(start));
+        d1.push_back(start);
+        d2.push_back(start);
+    }
+    const Size n = d1.size();
+
+    for (Size k=0; k<LENGTH(dayCounters); ++k) {
+        const DayCounter& dc = dayCounters[k];
+
+        std::vector<Date::serial_type> days(n);
+        std::vector<Time> times(n);
+        dc.dayCounts(&d1[0], &d2[0], &days[0], n);
+        dc.yearFractions(&d1[0], &d2[0], &times[0], n);
+
+        for (Size i=0; i<n; ++i) {
+            Date::serial_type expectedDays = dc.dayCount(d1[i], d2[i]);
+            Time expectedTime = dc.yearFraction(d1[i], d2[i]);
+            if (days[i] != expectedDays)
+                BOOST_ERROR(dc.name() << ": bulk day count between "
+                            << d1[i] << " and " << d2[i] << "\n"
+                            << "    calculated: " << days[i] << "\n"
+                            << "    expected:   " << expectedDays);
+            if (times[i] != expectedTime)
+                BOOST_ERROR(dc.name() << ": bulk year fraction between "
+                            << d1[i] << " and " << d2[i] << "\n"
+                            << std::setprecision(12)
+                            << "    calculated: " << times[i] << "\n"
+                            << "    expected:   " << expectedTime);
+        }
+    }
+}
+
+
 test_suite* DayCounterTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Day counter tests");
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testActualActual));
@@ -865,6 +927,8 @@ test_suite* DayCounterTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testThirty360_German));
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testActual365_Canadian));
 
+    suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testBulkCalculations));
+
 #ifdef QL_HIGH_RESOLUTION_DATE
     suite->add(QUANTLIB_TEST_CASE(&DayCounterTest::testIntraday));
 #endif
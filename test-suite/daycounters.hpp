@@ -39,6 +39,7 @@ class DayCounterTest {
     static void testThirty360_German();
     static void testActual365_Canadian();
     static void testIntraday();
+    static void testBulkCalculations();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -753,6 +753,44 @@ void DistributionTest::testSankaranApproximation() {
     }
 }
 
+void DistributionTest::testInverseCumulativeNormalSequence() {
+
+    BOOST_TEST_MESSAGE("Testing sequence transform of the inverse "
+                       "cumulative normal distribution...");
+
+    const Size N = 10001;
+    std::vector<Real> x(N);
+    for (Size i=0; i<N; ++i)
+        x[i] = (i+0.5)/N;
+    // make sure both tails are well represented
+    x[0] = 1.0e-12;
+    x[N-1] = 1.0 - 1.0e-12;
+
+    const InverseCumulativeNormal invCum(average, sigma);
+
+    std::vector<Real> y(N);
+    invCum(&x[0], &x[0]+N, &y[0]);
+
+    // in place
+    std::vector<Real> z(x);
+    invCum(&z[0], &z[0]+N, &z[0]);
+
+    const Real tolerance = 1.0e-15;
+    for (Size i=0; i<N; ++i) {
+        Real expected = invCum(x[i]);
+        Real scale = std::max(1.0, std::fabs(expected));
+        if (std::fabs(y[i]-expected) > tolerance*scale
+            || std::fabs(z[i]-expected) > tolerance*scale)
+            BOOST_ERROR("failed to reproduce the inverse cumulative "
+                        "normal distribution"
+                        << std::scientific
+                        << "\n    x:          " << x[i]
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << y[i]
+                        << "\n    in place:   " << z[i]);
+    }
+}
+
 test_suite* DistributionTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Distribution tests");
 
@@ -770,6 +808,9 @@ test_suite* DistributionTest::suite(SpeedLevel speed) {
     suite->add(QUANTLIB_TEST_CASE(
                    &DistributionTest::testSankaranApproximation));
 
+    suite->add(QUANTLIB_TEST_CASE(
+                   &DistributionTest::testInverseCumulativeNormalSequence));
+
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
             &DistributionTest::testBivariateCumulativeStudentVsBivariate));
@@ -39,6 +39,7 @@ class DistributionTest {
     static void testBivariateCumulativeStudentVsBivariate();
     static void testInvCDFviaStochasticCollocation();
     static void testSankaranApproximation();
+    static void testInverseCumulativeNormalSequence();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
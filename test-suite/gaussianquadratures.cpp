@@ -188,6 +188,65 @@ void GaussianQuadraturesTest::testTabulated() {
                          (2.0/5.0), 1.0e-13);
 }
 
+void GaussianQuadraturesTest::testSharedRules() {
+     BOOST_TEST_MESSAGE("Testing sharing of Gaussian quadrature rules...");
+
+     const GaussLaguerreIntegration laguerre(128);
+     const GaussLaguerreIntegration otherLaguerre(128);
+     if (laguerre.x() != otherLaguerre.x()
+         || laguerre.weights() != otherLaguerre.weights())
+         BOOST_ERROR("Gauss-Laguerre rules of the same order differ");
+
+     const GaussLaguerreIntegration shiftedLaguerre(128, 0.5);
+     const GaussLegendreIntegration legendre(128);
+     const GaussJacobiIntegration jacobi(128, 0.0, 0.0);
+     if (laguerre.x() == shiftedLaguerre.x()
+         || laguerre.x() == legendre.x())
+         BOOST_ERROR("rules with different parameters shared");
+     if (legendre.x() != jacobi.x())
+         BOOST_ERROR("Gauss-Legendre and Gauss-Jacobi(0, 0) rules differ");
+
+     // shared rules are the same as freshly calculated ones
+     const GaussianQuadrature generic(128, GaussLaguerrePolynomial());
+     for (Size i=0; i < generic.order(); ++i) {
+         if (generic.x()[i] != laguerre.x()[i]
+             || generic.weights()[i] != laguerre.weights()[i])
+             BOOST_ERROR("shared rule differs from calculated one at node "
+                         << i
+                         << "\n    shared:     " << laguerre.x()[i]
+                         << ", " << laguerre.weights()[i]
+                         << "\n    calculated: " << generic.x()[i]
+                         << ", " << generic.weights()[i]);
+     }
+
+     // rules stored and retrieved concurrently
+     const Size nOrders = 40;
+     std::vector<Array> nodes(nOrders);
+     #pragma omp parallel for schedule(dynamic)
+     for (long i=0; i < (long)(2*nOrders); ++i) {
+         const GaussHermiteIntegration hermite(i % nOrders + 1, 0.25);
+         if (i >= (long)nOrders)
+             nodes[i % nOrders] = hermite.x();
+     }
+     for (Size i=0; i < nOrders; ++i) {
+         const GaussianQuadrature expected(i+1, GaussHermitePolynomial(0.25));
+         if (nodes[i] != expected.x())
+             BOOST_ERROR("failed to reproduce Gauss-Hermite rule of order "
+                         << i+1 << " built concurrently");
+     }
+
+     // the table is cleared when full, without affecting the results
+     for (Size i=0; i < 600; ++i) {
+         const Real s = 0.001*i;
+         const GaussLaguerreIntegration stored(8, s);
+         const GaussianQuadrature expected(8, GaussLaguerrePolynomial(s));
+         if (stored.x() != expected.x()
+             || stored.weights() != expected.weights())
+             BOOST_ERROR("failed to reproduce Gauss-Laguerre rule "
+                         "with s = " << s);
+     }
+}
+
 void GaussianQuadraturesTest::testNonCentralChiSquared() {
      BOOST_TEST_MESSAGE(
          "Testing Gauss non-central chi-squared integration...");
@@ -256,6 +315,7 @@ test_suite* GaussianQuadraturesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testHermite));
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testHyperbolic));
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testTabulated));
+    suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testSharedRules));
     return suite;
 }
 
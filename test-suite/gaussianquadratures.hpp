@@ -32,6 +32,7 @@ class GaussianQuadraturesTest {
     static void testHermite();
     static void testHyperbolic();
     static void testTabulated();
+    static void testSharedRules();
     static void testNonCentralChiSquared();
     static void testNonCentralChiSquaredSumOfNotes();
 
@@ -285,9 +285,102 @@ void GsrTest::testGsrModel() {
                     << GsrJamNpv << ")");
 }
 
+void GsrTest::testStateGridCaching() {
+
+    BOOST_TEST_MESSAGE("Testing GSR model state grid caching...");
+
+    SavedSettings backup;
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    std::vector<Date> stepDates;
+    for (Size i = 1; i < 10; i++)
+        stepDates.push_back(refDate + (i * Years));
+    std::vector<Real> vols(stepDates.size() + 1, 0.01);
+    std::vector<Real> reversions(1, 0.01);
+
+    RelinkableHandle<YieldTermStructure> yts(
+        ext::shared_ptr<YieldTermStructure>(
+            new FlatForward(0, TARGET(), 0.03, Actual365Fixed())));
+
+    ext::shared_ptr<Gsr> model(
+        new Gsr(yts, stepDates, vols, reversions, 50.0));
+    ext::shared_ptr<Gsr> cachedModel(
+        new Gsr(yts, stepDates, vols, reversions, 50.0));
+    cachedModel->enableStateGridCaching();
+
+    // a bermudan book priced on the same model by different engines
+    ext::shared_ptr<SwapIndex> swpIdx(new EuriborSwapIsdaFixA(10 * Years, yts));
+    Date start = TARGET().advance(refDate, 1 * Years);
+    std::vector<ext::shared_ptr<Instrument> > swaptions;
+    for (Size i = 0; i < 3; i++) {
+        ext::shared_ptr<VanillaSwap> underlying =
+            MakeVanillaSwap(10 * Years, swpIdx->iborIndex(), 0.025 + 0.005 * i)
+                .withEffectiveDate(start)
+                .withFixedLegCalendar(swpIdx->fixingCalendar())
+                .withFixedLegDayCount(swpIdx->dayCounter())
+                .withFixedLegTenor(swpIdx->fixedLegTenor())
+                .withFixedLegConvention(swpIdx->fixedLegConvention())
+                .withFixedLegTerminationDateConvention(
+                     swpIdx->fixedLegConvention());
+        std::vector<Date> exerciseDates;
+        for (Size j = 0; j < underlying->fixedLeg().size() - 1; j++)
+            exerciseDates.push_back(swpIdx->fixingDate(
+                ext::dynamic_pointer_cast<Coupon>(underlying->fixedLeg()[j])
+                    ->accrualStartDate()));
+        ext::shared_ptr<Exercise> exercise(
+            new BermudanExercise(exerciseDates));
+        Swaption swaption(underlying, exercise);
+        swaptions.push_back(ext::make_shared<Swaption>(swaption));
+        swaptions.push_back(ext::make_shared<NonstandardSwaption>(swaption));
+    }
+
+    ext::shared_ptr<PricingEngine> engines[] = {
+        ext::make_shared<Gaussian1dSwaptionEngine>(model, 64, 7.0),
+        ext::make_shared<Gaussian1dSwaptionEngine>(cachedModel, 64, 7.0),
+        ext::make_shared<Gaussian1dNonstandardSwaptionEngine>(
+            model, 64, 7.0, true, false),
+        ext::make_shared<Gaussian1dNonstandardSwaptionEngine>(
+            cachedModel, 64, 7.0, true, false)
+    };
+
+    const Real tol = 1E-12;
+
+    // the cache must be flushed when the parameters or the curve change
+    for (Size k = 0; k < 3; k++) {
+        if (k == 1) {
+            Array params = model->params();
+            params[0] = 0.03;
+            params[5] = 0.015;
+            model->setParams(params);
+            cachedModel->setParams(params);
+        }
+        if (k == 2) {
+            yts.linkTo(ext::shared_ptr<YieldTermStructure>(
+                new FlatForward(0, TARGET(), 0.02, Actual365Fixed())));
+        }
+        for (Size i = 0; i < swaptions.size(); i++) {
+            // even indices are standard, odd ones nonstandard swaptions
+            Size e = 2 * (i % 2);
+            swaptions[i]->setPricingEngine(engines[e]);
+            Real npv = swaptions[i]->NPV();
+            swaptions[i]->setPricingEngine(engines[e + 1]);
+            Real cachedNpv = swaptions[i]->NPV();
+            if (fabs(npv - cachedNpv) > tol)
+                BOOST_ERROR("failed to reproduce bermudan swaption npv "
+                            "with state grid caching"
+                            << "\n    scenario: " << k
+                            << "\n    swaption: " << i
+                            << "\n    npv:      " << npv
+                            << "\n    cached:   " << cachedNpv);
+        }
+    }
+}
+
 test_suite *GsrTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("GSR model tests");
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrProcess));
     suite->add(QUANTLIB_TEST_CASE(&GsrTest::testGsrModel));
+    suite->add(QUANTLIB_TEST_CASE(&GsrTest::testStateGridCaching));
     return suite;
 }
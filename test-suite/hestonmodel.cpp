@@ -27,6 +27,9 @@
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
+#include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/vanilla/hestonexpansionengine.hpp>
@@ -64,9 +67,39 @@ namespace {
         Handle<Quote> s0;
         Handle<YieldTermStructure> riskFreeTS, dividendYield;
         std::vector<ext::shared_ptr<CalibrationHelper> > options;
+        std::vector<Real> strikes;
     };
 
-    CalibrationMarketData getDAXCalibrationMarketData() {
+    // counts the analytic gradients of the model value it provides
+    class CountingHestonModelHelper : public HestonModelHelper {
+      public:
+        CountingHestonModelHelper(
+                const Period& maturity,
+                const Calendar& calendar,
+                const Handle<Quote>& s0,
+                Real strikePrice,
+                const Handle<Quote>& volatility,
+                const Handle<YieldTermStructure>& riskFreeRate,
+                const Handle<YieldTermStructure>& dividendYield,
+                BlackCalibrationHelper::CalibrationErrorType errorType,
+                Size& gradientCalls)
+        : HestonModelHelper(maturity, calendar, s0, strikePrice, volatility,
+                            riskFreeRate, dividendYield, errorType),
+          gradientCalls_(gradientCalls) {}
+        Disposable<Array> modelValueGradient() const {
+            Array gradient = HestonModelHelper::modelValueGradient();
+            if (!gradient.empty())
+                ++gradientCalls_;
+            return gradient;
+        }
+      private:
+        Size& gradientCalls_;
+    };
+
+    /* if gradientCalls is given, the helpers add to it the number of
+       analytic gradients returned by their modelValueGradient() */
+    CalibrationMarketData getDAXCalibrationMarketData(
+                                             Size* gradientCalls = 0) {
         /* this example is taken from A. Sepp
            Pricing European-Style Options under Jump Diffusion Processes
            with Stochstic Volatility: Applications of Fourier Transform
@@ -123,17 +156,50 @@ namespace {
                 Handle<Quote> vol(ext::make_shared<SimpleQuote>(v[s*8+m]));
         
                 Period maturity((int)((t[m]+3)/7.), Weeks); // round to weeks
-                options.push_back(ext::make_shared<HestonModelHelper>(maturity, calendar,
-                                              s0, strike[s], vol,
-                                              riskFreeTS, dividendYield,
-                                          BlackCalibrationHelper::ImpliedVolError));
+                if (gradientCalls != 0) {
+                    options.push_back(
+                        ext::make_shared<CountingHestonModelHelper>(
+                                maturity, calendar, s0, strike[s], vol,
+                                riskFreeTS, dividendYield,
+                                BlackCalibrationHelper::ImpliedVolError,
+                                *gradientCalls));
+                } else {
+                    options.push_back(ext::make_shared<HestonModelHelper>(
+                                maturity, calendar, s0, strike[s], vol,
+                                riskFreeTS, dividendYield,
+                                BlackCalibrationHelper::ImpliedVolError));
+                }
             }
         }
         
-        CalibrationMarketData marketData = { s0, riskFreeTS, dividendYield, options };
+        CalibrationMarketData marketData = {
+            s0, riskFreeTS, dividendYield, options,
+            std::vector<Real>(strike, strike + LENGTH(strike)) };
         
         return marketData;
     }
+
+    // calibrates the model and checks the resulting error against
+    // the one reported by A. Sepp for the DAX data above
+    void checkDAXCalibration(
+                const ext::shared_ptr<HestonModel>& model,
+                const std::vector<ext::shared_ptr<CalibrationHelper> >& options,
+                OptimizationMethod& method) {
+        model->calibrate(options, method,
+                         EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+        Real sse = 0;
+        for (Size i = 0; i < options.size(); ++i) {
+            const Real diff = options[i]->calibrationError()*100.0;
+            sse += diff*diff;
+        }
+        const Real expected = 177.2;
+        if (std::fabs(sse - expected) > 1.0) {
+            BOOST_FAIL("Failed to reproduce calibration error"
+                       << "\n    calculated: " << sse
+                       << "\n    expected:   " << expected);
+        }
+    }
         
 }
 
@@ -278,20 +344,7 @@ void HestonModelTest::testDAXCalibration() {
             ext::dynamic_pointer_cast<BlackCalibrationHelper>(options[i])->setPricingEngine(engines[j]);
 
         LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
-        model->calibrate(options, om,
-                         EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
-
-        Real sse = 0;
-        for (Size i = 0; i < 13*8; ++i) {
-            const Real diff = options[i]->calibrationError()*100.0;
-            sse += diff*diff;
-        }
-        Real expected = 177.2; //see article by A. Sepp.
-        if (std::fabs(sse - expected) > 1.0) {
-            BOOST_FAIL("Failed to reproduce calibration error"
-                       << "\n    calculated: " << sse
-                       << "\n    expected:   " << expected);
-        }
+        checkDAXCalibration(model, options, om);
     }
 }
 
@@ -2721,16 +2774,338 @@ void HestonModelTest::testPiecewiseTimeDependentChFAsymtotic() {
     }
 }
 
+void HestonModelTest::testParallelCalibration() {
+    BOOST_TEST_MESSAGE("Testing parallel Heston model calibration...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options =
+        marketData.options;
+
+    Array calibrated[2], errors[2];
+    Integer evaluations[2];
+    for (Size k=0; k<2; ++k) {
+        const ext::shared_ptr<HestonModel> model(
+            ext::make_shared<HestonModel>(
+                ext::make_shared<HestonProcess>(
+                    marketData.riskFreeTS, marketData.dividendYield,
+                    marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+        // sequential calibration with a single engine, parallel
+        // calibration with one engine per helper
+        const ext::shared_ptr<PricingEngine> engine =
+            ext::make_shared<AnalyticHestonEngine>(model, 64);
+        for (Size i = 0; i < options.size(); ++i)
+            ext::dynamic_pointer_cast<BlackCalibrationHelper>(options[i])
+                ->setPricingEngine(k == 0 ? engine :
+                    ext::make_shared<AnalyticHestonEngine>(model, 64));
+        model->enableParallelCalibration(k == 1);
+
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+        model->calibrate(options, om,
+                         EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+        calibrated[k] = model->params();
+        errors[k] = model->problemValues();
+        evaluations[k] = model->functionEvaluation();
+    }
+
+    if (calibrated[0] != calibrated[1]
+        || errors[0] != errors[1]
+        || evaluations[0] != evaluations[1])
+        BOOST_FAIL("parallel calibration differs from sequential one"
+                   << std::setprecision(16)
+                   << "\n    sequential: " << calibrated[0]
+                   << " (" << evaluations[0] << " evaluations)"
+                   << "\n    parallel:   " << calibrated[1]
+                   << " (" << evaluations[1] << " evaluations)");
+
+    // helpers are grouped by engine, whether OpenMP is enabled or not
+    std::vector<std::vector<Size> > groups =
+        CalibratedModel::calibrationGroups(options);
+    if (groups.size() != options.size())
+        BOOST_ERROR("unexpected number of groups for separate engines: "
+                    << groups.size() << " (expected " << options.size()
+                    << ")");
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+    const ext::shared_ptr<PricingEngine> engines[] = {
+        ext::make_shared<AnalyticHestonEngine>(model, 64),
+        ext::make_shared<AnalyticHestonEngine>(model, 64)
+    };
+    for (Size i = 0; i < options.size(); ++i)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(options[i])
+            ->setPricingEngine(engines[i % 2]);
+
+    groups = CalibratedModel::calibrationGroups(options);
+    if (groups.size() != 2)
+        BOOST_FAIL("unexpected number of groups for two engines: "
+                   << groups.size() << " (expected 2)");
+    for (Size g = 0; g < 2; ++g) {
+        if (groups[g].size() != (options.size() + 1 - g)/2)
+            BOOST_ERROR("unexpected size of group #" << g << ": "
+                        << groups[g].size());
+        for (Size j = 0; j < groups[g].size(); ++j) {
+            if (groups[g][j] != 2*j + g)
+                BOOST_ERROR("unexpected helper #" << groups[g][j]
+                            << " in group #" << g << " at position " << j);
+        }
+    }
+
+    // swaption Black prices build engines registering with the
+    // discount curve, so that they can't be calculated concurrently
+    std::vector<ext::shared_ptr<CalibrationHelper> > helpers = options;
+    helpers.push_back(ext::make_shared<SwaptionHelper>(
+        Period(1, Years), Period(5, Years),
+        Handle<Quote>(ext::make_shared<SimpleQuote>(0.2)),
+        ext::make_shared<Euribor6M>(marketData.riskFreeTS),
+        Period(1, Years), Thirty360(), Actual360(),
+        marketData.riskFreeTS, BlackCalibrationHelper::ImpliedVolError));
+    groups = CalibratedModel::calibrationGroups(helpers);
+    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    const Size expectedGroups = 3;
+    #else
+    const Size expectedGroups = 1;
+    #endif
+    if (groups.size() != expectedGroups)
+        BOOST_ERROR("unexpected number of groups with swaption helper: "
+                    << groups.size() << " (expected " << expectedGroups
+                    << ")");
+}
+
+void HestonModelTest::testAnalyticValueGradient() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing analytic Heston gradient and its use in calibration...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    Size gradientCalls = 0;
+    CalibrationMarketData marketData =
+        getDAXCalibrationMarketData(&gradientCalls);
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options =
+        marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const ext::shared_ptr<AnalyticHestonEngine> engines[] = {
+        ext::make_shared<AnalyticHestonEngine>(model, 64),
+        ext::make_shared<AnalyticHestonEngine>(
+            model, AnalyticHestonEngine::Gatheral,
+            AnalyticHestonEngine::Integration::gaussLegendre(128))
+    };
+
+    // compare with central differences
+    const Array params = model->params();
+    const Real h = 1e-5;
+    for (Size j=0; j < LENGTH(engines); ++j) {
+        for (Size i=0; i < options.size(); i+=7) {
+            const ext::shared_ptr<BlackCalibrationHelper> helper =
+                ext::dynamic_pointer_cast<BlackCalibrationHelper>(options[i]);
+            helper->setPricingEngine(engines[j]);
+
+            model->setParams(params);
+            const Array gradient = helper->modelValueGradient();
+            if (gradient.size() != params.size())
+                BOOST_FAIL("analytic gradient not available");
+
+            for (Size k=0; k < params.size(); ++k) {
+                Array p = params;
+                p[k] += h;
+                model->setParams(p);
+                const Real up = helper->modelValue();
+                p[k] -= 2*h;
+                model->setParams(p);
+                const Real down = helper->modelValue();
+                const Real expected = (up - down)/(2*h);
+
+                if (std::fabs(gradient[k] - expected)
+                                    > 1e-5*std::max(1.0, std::fabs(expected)))
+                    BOOST_ERROR("failed to reproduce derivative "
+                               << "with respect to parameter " << k
+                               << " of option " << i
+                               << "\n    analytic:    " << gradient[k]
+                               << "\n    numerical:   " << expected);
+            }
+        }
+    }
+
+    // calibrate with the analytic Jacobian
+    model->setParams(params);
+    for (Size i=0; i < options.size(); ++i)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(options[i])
+            ->setPricingEngine(engines[0]);
+
+    gradientCalls = 0;
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    checkDAXCalibration(model, options, om);
+
+    // the Jacobian must have been built from the analytic gradients,
+    // i.e., at least once for each helper
+    if (gradientCalls < options.size())
+        BOOST_ERROR("analytic gradient not used in calibration"
+                    << "\n    gradient calls: " << gradientCalls
+                    << "\n    helpers:        " << options.size());
+}
+
+void HestonModelTest::testAnalyticMultipleStrikesEngines() {
+    BOOST_TEST_MESSAGE(
+        "Testing multiple-strikes analytic and COS Heston engines...");
+
+    SavedSettings backup;
+
+    Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    DayCounter dayCounter = ActualActual();
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.06, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+
+    Handle<Quote> s0(ext::make_shared<SimpleQuote>(1.05));
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.16, 2.5, 0.09, 0.8, -0.8)));
+
+    std::vector<Real> strikes;
+    for (Size i=0; i < 20; ++i)
+        strikes.push_back(0.5 + 0.075*i);
+
+    const Date exerciseDates[] = {
+        Date(28, March, 2005), Date(28, March, 2006) };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    std::vector<std::pair<ext::shared_ptr<PricingEngine>,
+                          ext::shared_ptr<PricingEngine> > > engines;
+    for (Size i=0; i < 4; ++i) {
+        ext::shared_ptr<PricingEngine> singleStrikeEngine, multiStrikeEngine;
+        if (i < 3) {
+            ext::shared_ptr<AnalyticHestonEngine> e[2];
+            for (Size j=0; j < 2; ++j) {
+                switch (i) {
+                  case 0:
+                    e[j] = ext::make_shared<AnalyticHestonEngine>(model, 144);
+                    break;
+                  case 1:
+                    e[j] = ext::make_shared<AnalyticHestonEngine>(
+                        model, AnalyticHestonEngine::Gatheral,
+                        AnalyticHestonEngine::Integration::gaussLegendre(128));
+                    break;
+                  default:
+                    e[j] = ext::make_shared<AnalyticHestonEngine>(
+                                                        model, 1e-8, 10000);
+                }
+            }
+            e[1]->enableMultipleStrikesCaching(strikes);
+            singleStrikeEngine = e[0];
+            multiStrikeEngine = e[1];
+        } else {
+            ext::shared_ptr<COSHestonEngine> e =
+                ext::make_shared<COSHestonEngine>(model, 16, 200);
+            e->enableMultipleStrikesCaching(strikes);
+            singleStrikeEngine =
+                ext::make_shared<COSHestonEngine>(model, 16, 200);
+            multiStrikeEngine = e;
+        }
+        engines.push_back(std::make_pair(singleStrikeEngine,
+                                         multiStrikeEngine));
+    }
+
+    const Real tol = 1e-10;
+    for (Size n=0; n < 2; ++n) {
+        if (n == 1) {
+            // the cached values must be dropped when the model changes
+            Array params = model->params();
+            params[2] = 0.5;
+            model->setParams(params);
+        }
+
+        for (Size i=0; i < engines.size(); ++i) {
+            for (Size j=0; j < LENGTH(exerciseDates); ++j) {
+                for (Size k=0; k < strikes.size(); ++k) {
+                    for (Size l=0; l < LENGTH(types); ++l) {
+                        VanillaOption option(
+                            ext::make_shared<PlainVanillaPayoff>(
+                                                   types[l], strikes[k]),
+                            ext::make_shared<EuropeanExercise>(
+                                                   exerciseDates[j]));
+
+                        option.setPricingEngine(engines[i].first);
+                        const Real expected = option.NPV();
+                        option.setPricingEngine(engines[i].second);
+                        const Real calculated = option.NPV();
+
+                        if (std::fabs(calculated - expected) > tol)
+                            BOOST_ERROR("failed to reproduce price with "
+                                        "multiple-strikes engine " << i
+                                << std::setprecision(12)
+                                << "\n    strike:     " << strikes[k]
+                                << "\n    expiry:     " << exerciseDates[j]
+                                << "\n    type:       " << types[l]
+                                << "\n    calculated: " << calculated
+                                << "\n    expected:   " << expected);
+                    }
+                }
+            }
+        }
+    }
+
+    // calibration on a whole volatility surface
+    Settings::instance().evaluationDate() = Date(5, July, 2002);
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const ext::shared_ptr<HestonModel> daxModel(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const ext::shared_ptr<AnalyticHestonEngine> engine =
+        ext::make_shared<AnalyticHestonEngine>(daxModel, 64);
+    engine->enableMultipleStrikesCaching(marketData.strikes);
+
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options =
+        marketData.options;
+    for (Size i=0; i < options.size(); ++i)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(options[i])
+            ->setPricingEngine(engine);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+    checkDAXCalibration(daxModel, options, om);
+}
+
 test_suite* HestonModelTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBlackCalibration));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testParallelCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticValueGradient));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDifferentIntegrals));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdVanillaVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testAnalyticMultipleStrikesEngines));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMcVsCached));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testAnalyticPiecewiseTimeDependent));
@@ -30,6 +30,8 @@ class HestonModelTest {
   public:
     static void testBlackCalibration();
     static void testDAXCalibration();
+    static void testParallelCalibration();
+    static void testAnalyticValueGradient();
     static void testAnalyticVsBlack();
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
@@ -38,6 +40,7 @@ class HestonModelTest {
     static void testFdVanillaVsCached();    
     static void testDifferentIntegrals();
     static void testMultipleStrikesEngine();
+    static void testAnalyticMultipleStrikesEngines();
     static void testAnalyticPiecewiseTimeDependent();
     static void testDAXCalibrationOfTimeDependentModel();
     static void testAlanLewisReferencePrices();
@@ -26,6 +26,7 @@
 #include "utilities.hpp"
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/null.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
@@ -33,6 +34,7 @@
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
+#include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/math/interpolations/kernelinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
 #include <ql/math/interpolations/lagrangeinterpolation.hpp>
@@ -2034,6 +2036,66 @@ void InterpolationTest::testSabrSingleCases() {
 
 }
 
+void InterpolationTest::testSabrSmileSectionVolatilities() {
+
+    BOOST_TEST_MESSAGE("Testing Sabr smile section volatilities "
+                       "for multiple strikes...");
+
+    SavedSettings backup;
+
+    using namespace boost::assign;
+    std::vector<Real> params;
+    params += 0.026, 0.5, 0.4, -0.1;
+    Real forward = 0.0488, shift = 0.01, tte = 1.5;
+
+    std::vector<Rate> strikes;
+    for (Rate k = -0.0150; k < 0.15; k += 0.0005)
+        strikes.push_back(k);
+    strikes.push_back(forward);
+
+    SabrSmileSection section(tte, forward, params, shift);
+    std::vector<Volatility> vols;
+    section.volatilities(strikes, vols);
+
+    for (Size i=0; i<strikes.size(); ++i) {
+        Rate strike = std::max(0.00001 - shift, strikes[i]);
+        Volatility expected =
+            shiftedSabrVolatility(strike, forward, tte, params[0], params[1],
+                                  params[2], params[3], shift);
+        if (vols[i] != expected || section.volatility(strikes[i]) != expected)
+            BOOST_ERROR("failed to reproduce Sabr volatility at strike "
+                        << io::rate(strikes[i])
+                        << "\n    expected:     " << expected
+                        << "\n    single:       "
+                        << section.volatility(strikes[i])
+                        << "\n    multiple:     " << vols[i]);
+    }
+
+    // the precomputed terms must follow a floating reference date
+    Date today(15, March, 2019);
+    Settings::instance().evaluationDate() = today;
+    Actual365Fixed dc;
+    Date expiry = today + 18*Months;
+    SabrSmileSection datedSection(expiry, forward, params, dc);
+
+    Settings::instance().evaluationDate() = today + 3*Months;
+    Time t = dc.yearFraction(today + 3*Months, expiry);
+    datedSection.volatilities(strikes, vols);
+    for (Size i=0; i<strikes.size(); ++i) {
+        if (strikes[i] < 0.00001)
+            continue;
+        Volatility expected =
+            sabrVolatility(strikes[i], forward, t, params[0], params[1],
+                           params[2], params[3]);
+        if (std::fabs(vols[i] - expected) > 1.0e-15)
+            BOOST_ERROR("failed to reproduce Sabr volatility at strike "
+                        << io::rate(strikes[i])
+                        << " after moving the evaluation date"
+                        << "\n    expected:     " << expected
+                        << "\n    calculated:   " << vols[i]);
+    }
+}
+
 void InterpolationTest::testTransformations() {
 
     BOOST_TEST_MESSAGE("Testing Sabr and no-arbitrage Sabr transformation functions...");
@@ -2484,6 +2546,8 @@ test_suite* InterpolationTest::suite() {
                             &InterpolationTest::testRichardsonExtrapolation));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testNoArbSabrInterpolation));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSabrSingleCases));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &InterpolationTest::testSabrSmileSectionVolatilities));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testTransformations));
     suite->add(QUANTLIB_TEST_CASE(
         &InterpolationTest::testLagrangeInterpolation));
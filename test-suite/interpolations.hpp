@@ -53,6 +53,7 @@ class InterpolationTest {
     static void testRichardsonExtrapolation();
     static void testNoArbSabrInterpolation();
     static void testSabrSingleCases();
+    static void testSabrSmileSectionVolatilities();
     static void testFlochKennedySabrIsSmoothAroundATM();
     static void testLeFlochKennedySabrExample();
     static void testTransformations();
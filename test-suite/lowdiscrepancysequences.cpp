@@ -30,6 +30,7 @@
 #include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/partitionedsobolrsg.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/math/randomnumbers/latticerules.hpp>
 #include <ql/math/randomnumbers/latticersg.hpp>
@@ -1091,6 +1092,70 @@ void LowDiscrepancyTest::testSobolSkipping() {
     }
 }
 
+void LowDiscrepancyTest::testSobolPartitioning() {
+
+    BOOST_TEST_MESSAGE("Testing Sobol sequence generation over partitions...");
+
+    unsigned long seed = 42;
+    Size dimensionality[] = { 1, 10, 100 };
+    Size partitions[] = { 1, 3, 8 };
+    Size samples = 1000;
+
+    for (Size j=0; j<LENGTH(dimensionality); j++) {
+        Size dim = dimensionality[j];
+
+        // serial reference
+        SobolRsg rsg(dim, seed);
+        Matrix expected(2*samples, dim);
+        for (Size i=0; i<2*samples; i++) {
+            const std::vector<Real>& x = rsg.nextSequence().value;
+            std::copy(x.begin(), x.end(), expected.row_begin(i));
+        }
+
+        // one call for a block of points
+        SobolRsg blockRsg(dim, seed);
+        Matrix block(2*samples, dim);
+        blockRsg.nextSequences(samples, block.row_begin(0));
+        blockRsg.nextSequences(samples, block.row_begin(samples));
+
+        for (Size i=0; i<2*samples; i++) {
+            for (Size k=0; k<dim; k++) {
+                if (block[i][k] != expected[i][k])
+                    BOOST_FAIL("Mismatch in block generation:"
+                               << "\n  size:     " << dim
+                               << "\n  sample:   " << i
+                               << "\n  at index: " << k
+                               << "\n  expected: " << expected[i][k]
+                               << "\n  found:    " << block[i][k]);
+            }
+        }
+
+        for (Size l=0; l<LENGTH(partitions); l++) {
+            // two consecutive requests, then a jump back
+            PartitionedSobolRsg partitioned(dim, seed, SobolRsg::Jaeckel,
+                                            partitions[l]);
+            Matrix first(samples, dim), second(samples, dim),
+                   middle(samples, dim);
+            partitioned.nextSequences(first);
+            partitioned.nextSequences(second);
+            partitioned.sequences(samples/2, middle);
+
+            for (Size i=0; i<samples; i++) {
+                for (Size k=0; k<dim; k++) {
+                    if (first[i][k] != expected[i][k]
+                        || second[i][k] != expected[samples+i][k]
+                        || middle[i][k] != expected[samples/2+i][k])
+                        BOOST_FAIL("Mismatch in partitioned generation:"
+                                   << "\n  size:       " << dim
+                                   << "\n  partitions: " << partitions[l]
+                                   << "\n  sample:     " << i
+                                   << "\n  at index:   " << k);
+                }
+            }
+        }
+    }
+}
+
 
 test_suite* LowDiscrepancyTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Low-discrepancy sequence tests");
@@ -1129,6 +1194,8 @@ test_suite* LowDiscrepancyTest::suite() {
            &LowDiscrepancyTest::testSobolLevitanLemieuxSobolDiscrepancy));
 
     suite->add(QUANTLIB_TEST_CASE(&LowDiscrepancyTest::testSobolSkipping));
+    suite->add(QUANTLIB_TEST_CASE(
+                             &LowDiscrepancyTest::testSobolPartitioning));
 
     suite->add(QUANTLIB_TEST_CASE(
            &LowDiscrepancyTest::testRandomizedLowDiscrepancySequence));
@@ -3628,6 +3628,116 @@ void MarketModelTest::testPathwiseVegas()
 
 }
 
+void MarketModelTest::testPathwiseVegasAgainstBumps()
+{
+    BOOST_TEST_MESSAGE(
+        "Testing pathwise vegas against bumped pseudo-roots...");
+
+    setup();
+
+    MarketModelPathwiseMultiCaplet caplets(rateTimes, accruals,
+        paymentTimes, todaysForwards);
+    MarketModelPathwiseMultiDeflatedCaplet capletsDeflated(rateTimes,
+        accruals, paymentTimes, todaysForwards);
+
+    const EvolutionDescription& evolution = caplets.evolution();
+    Size numberRates = evolution.numberOfRates();
+    Size numberSteps = evolution.numberOfSteps();
+    Size factors = 3;
+    Size paths = 1000;
+
+    ext::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, factors,
+                        ExponentialCorrelationAbcdVolatility);
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    // the whole pseudo-root of each step, and a single element on
+    // all steps
+    Size numberBumps = numberSteps+1;
+    std::vector<std::vector<Matrix> > vegaBumps(numberSteps,
+        std::vector<Matrix>(numberBumps, Matrix(numberRates, factors, 0.0)));
+    for (Size j=0; j < numberSteps; ++j) {
+        vegaBumps[j][j] = marketModel->pseudoRoot(j);
+        vegaBumps[j][numberSteps][numberRates-1][factors-1] = 1.0;
+    }
+
+    Clone<MarketModelPathwiseMultiProduct> products[] = {
+        caplets, capletsDeflated
+    };
+
+    for (Size p=0; p < LENGTH(products); ++p) {
+
+        std::vector<Real> values, values2, errors;
+        {
+            MTBrownianGeneratorFactory generatorFactory(seed_);
+            PathwiseVegasAccountingEngine engine(
+                ext::make_shared<LogNormalFwdRateEuler>(
+                    marketModel, generatorFactory, numeraires),
+                products[p], marketModel, vegaBumps, initialNumeraireValue);
+            engine.multiplePathValues(values, errors, paths);
+        }
+        {
+            MTBrownianGeneratorFactory generatorFactory(seed_);
+            PathwiseVegasOuterAccountingEngine engine(
+                ext::make_shared<LogNormalFwdRateEuler>(
+                    marketModel, generatorFactory, numeraires),
+                products[p], marketModel, vegaBumps, initialNumeraireValue);
+            engine.multiplePathValues(values2, errors, paths);
+        }
+
+        // the pathwise vegas are the derivatives of the simulated
+        // prices, so they're compared with central differences of
+        // prices obtained with the same paths
+        Real h = 1.0e-6;
+        Size numberProducts = products[p]->numberOfProducts();
+        Size entriesPerProduct = 1+numberRates+numberBumps;
+        for (Size l=0; l < numberBumps; ++l) {
+            std::vector<Real> prices[2];
+            for (Size s=0; s<2; ++s) {
+                std::vector<Matrix> pseudoRoots(numberSteps);
+                for (Size j=0; j < numberSteps; ++j) {
+                    pseudoRoots[j] = vegaBumps[j][l];
+                    pseudoRoots[j] *= (s == 0 ? h : -h);
+                    pseudoRoots[j] += marketModel->pseudoRoot(j);
+                }
+                ext::shared_ptr<MarketModel> bumpedModel(
+                    new PseudoRootFacade(pseudoRoots,
+                                         evolution.rateTimes(),
+                                         marketModel->initialRates(),
+                                         marketModel->displacements()));
+                MTBrownianGeneratorFactory generatorFactory(seed_);
+                PathwiseVegasAccountingEngine engine(
+                    ext::make_shared<LogNormalFwdRateEuler>(
+                        bumpedModel, generatorFactory, numeraires),
+                    products[p], bumpedModel, vegaBumps,
+                    initialNumeraireValue);
+                engine.multiplePathValues(prices[s], errors, paths);
+            }
+
+            for (Size i=0; i < numberProducts; ++i) {
+                Size n = i*entriesPerProduct;
+                Real bumped = (prices[0][n]-prices[1][n])/(2.0*h);
+                Real tolerance = 1.0e-10 + 1.0e-3*std::fabs(bumped);
+                Real vega = values[n+1+numberRates+l];
+                Real vega2 = values2[n+1+numberRates+l];
+                if (std::fabs(vega-bumped) > tolerance)
+                    BOOST_ERROR("PathwiseVegasAccountingEngine vega "
+                                << vega << " differs from bumped vega "
+                                << bumped << "\n    product: " << i
+                                << "\n    bump:    " << l
+                                << "\n    deflated: " << p);
+                if (std::fabs(vega2-bumped) > tolerance)
+                    BOOST_ERROR("PathwiseVegasOuterAccountingEngine vega "
+                                << vega2 << " differs from bumped vega "
+                                << bumped << "\n    product: " << i
+                                << "\n    bump:    " << l
+                                << "\n    deflated: " << p);
+            }
+        }
+    }
+}
+
 void MarketModelTest::testPathwiseMarketVegas()
 {
 
@@ -4886,6 +4996,8 @@ test_suite* MarketModelTest::suite(SpeedLevel speed) {
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCovariance));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &MarketModelTest::testPathwiseVegasAgainstBumps));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPathwiseVegas));
@@ -46,6 +46,7 @@ class MarketModelTest {
     static void testGreeks();
     static void testPathwiseGreeks();
     static void testPathwiseVegas();
+    static void testPathwiseVegasAgainstBumps();
     static void testPathwiseMarketVegas();
     static void testStochVolForwardsAndOptionlets();
     static void testAbcdVolatilityIntegration();
@@ -24,6 +24,7 @@
 
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/experimental/volatility/noarbsabrsmilesection.hpp>
+#include <ql/experimental/volatility/noarbsabrinterpolation.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -122,10 +123,85 @@ void NoArbSabrTest::testConsistencyWithHagan() {
 
 }
 
+void NoArbSabrTest::testDensityGrid() {
+
+    BOOST_TEST_MESSAGE("Testing noarb-sabr prices on a density grid...");
+
+    Real tau = 1.0;
+    Real beta = 0.5;
+    Real alpha = 0.026;
+    Real rho = -0.1;
+    Real nu = 0.4;
+    Real f = 0.0488;
+
+    NoArbSabrModel integrated(tau, f, alpha, beta, nu, rho);
+    NoArbSabrModel tabulated(tau, f, alpha, beta, nu, rho);
+    tabulated.enableDensityGrid();
+
+    Real strike = 0.0001;
+    while (strike < 0.15) {
+        Real expected = integrated.optionPrice(strike);
+        Real calculated = tabulated.optionPrice(strike);
+        if (std::fabs(calculated - expected) > 1e-7)
+            BOOST_ERROR("inconsistent integrated price ("
+                        << expected << ") and tabulated price ("
+                        << calculated << ") at strike " << strike);
+        expected = integrated.digitalOptionPrice(strike);
+        calculated = tabulated.digitalOptionPrice(strike);
+        if (std::fabs(calculated - expected) > 1e-5)
+            BOOST_ERROR("inconsistent integrated digital ("
+                        << expected << ") and tabulated digital ("
+                        << calculated << ") at strike " << strike);
+        strike += 0.0005;
+    }
+
+    tabulated.disableDensityGrid();
+    strike = 0.03;
+    if (tabulated.optionPrice(strike) != integrated.optionPrice(strike))
+        BOOST_ERROR("price after disabling the density grid ("
+                    << tabulated.optionPrice(strike)
+                    << ") differs from integrated price ("
+                    << integrated.optionPrice(strike) << ")");
+
+    // the grid can be requested through the smile section and the
+    // interpolation as well
+    tabulated.enableDensityGrid(500);
+    std::vector<Real> params =
+        boost::assign::list_of(alpha)(beta)(nu)(rho);
+    NoArbSabrSmileSection section(tau, f, params, 0.0, 500);
+    std::vector<Real> strikes =
+        boost::assign::list_of(0.02)(0.03)(0.04)(0.05)(0.06)(0.08);
+    std::vector<Real> vols(strikes.size());
+    for (Size i = 0; i < strikes.size(); ++i) {
+        if (section.optionPrice(strikes[i]) !=
+            tabulated.optionPrice(strikes[i]))
+            BOOST_ERROR("price of smile section with density grid ("
+                        << section.optionPrice(strikes[i])
+                        << ") differs from tabulated price ("
+                        << tabulated.optionPrice(strikes[i])
+                        << ") at strike " << strikes[i]);
+        vols[i] = section.volatility(strikes[i]);
+    }
+
+    NoArbSabrInterpolation interpolation(
+        strikes.begin(), strikes.end(), vols.begin(), tau, f, alpha, beta,
+        nu, rho, true, true, true, true, false,
+        ext::shared_ptr<EndCriteria>(), ext::shared_ptr<OptimizationMethod>(),
+        0.0020, false, 50, 0.0, 500);
+    for (Size i = 0; i < strikes.size(); ++i) {
+        if (interpolation(strikes[i]) != vols[i])
+            BOOST_ERROR("volatility of interpolation with density grid ("
+                        << interpolation(strikes[i])
+                        << ") differs from smile section volatility ("
+                        << vols[i] << ") at strike " << strikes[i]);
+    }
+}
+
 
 test_suite* NoArbSabrTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("NoArbSabrModel tests");
     suite->add(QUANTLIB_TEST_CASE(&NoArbSabrTest::testAbsorptionMatrix));
     suite->add(QUANTLIB_TEST_CASE(&NoArbSabrTest::testConsistencyWithHagan));
+    suite->add(QUANTLIB_TEST_CASE(&NoArbSabrTest::testDensityGrid));
     return suite;
 }
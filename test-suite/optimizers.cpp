@@ -33,6 +33,9 @@
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/optimization/differentialevolution.hpp>
 #include <ql/math/optimization/goldstein.hpp>
+#include <ql/experimental/math/fireflyalgorithm.hpp>
+#include <ql/experimental/math/multistartlevenbergmarquardt.hpp>
+#include <ql/experimental/math/particleswarmoptimization.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -447,6 +450,74 @@ namespace {
             return fx - p + 1.0;
         }
     };
+
+    class ConcurrentGriewangk : public Griewangk {
+      public:
+        bool allowsConcurrentEvaluation() const { return true; }
+    };
+
+    // least-squares problem with a local minimum close to each
+    // point of the integer lattice; the global one is at the origin
+    class LatticeLeastSquares : public CostFunction {
+      public:
+        explicit LatticeLeastSquares(bool concurrent)
+        : concurrent_(concurrent) {}
+        Disposable<Array> values(const Array& x) const {
+            Array retVal(2*x.size());
+            for (Size i=0; i<x.size(); ++i) {
+                retVal[2*i] = x[i];
+                retVal[2*i+1] = std::sqrt(10.0)*std::sin(M_PI*x[i]);
+            }
+            return retVal;
+        }
+        Real value(const Array& x) const {
+            Array v = values(x);
+            return DotProduct(v, v);
+        }
+        bool allowsConcurrentEvaluation() const { return concurrent_; }
+      private:
+        bool concurrent_;
+    };
+
+    // fit of a * exp(-b * t) + c to the given data
+    class ExponentialFit : public CostFunction {
+      public:
+        ExponentialFit(const Array& data, bool concurrent)
+        : data_(data), concurrent_(concurrent) {}
+        Disposable<Array> values(const Array& x) const {
+            Array retVal(data_.size());
+            for (Size i=0; i<data_.size(); ++i)
+                retVal[i] = x[0]*std::exp(-x[1]*0.5*i) + x[2] - data_[i];
+            return retVal;
+        }
+        bool allowsConcurrentEvaluation() const { return concurrent_; }
+      private:
+        Array data_;
+        bool concurrent_;
+    };
+
+    ext::shared_ptr<OptimizationMethod> makeGlobalOptimizer(Size i) {
+        switch (i) {
+          case 0:
+            return ext::make_shared<DifferentialEvolution>(
+                DifferentialEvolution::Configuration()
+                .withBounds()
+                .withPopulationMembers(50)
+                .withStrategy(DifferentialEvolution::BestMemberWithJitter)
+                .withAdaptiveCrossover()
+                .withSeed(3242));
+          case 1:
+            return ext::make_shared<ParticleSwarmOptimization>(
+                50, ext::make_shared<KNeighbors>(10),
+                ext::make_shared<LevyFlightInertia>(1.5, 20, 1234UL),
+                2.05, 2.05, 1234UL);
+          default:
+            return ext::make_shared<FireflyAlgorithm>(
+                50, ext::make_shared<ExponentialIntensity>(10.0, 1e-8, 1.0),
+                ext::make_shared<LevyFlightWalk>(1.5, 0.5, 1.0, 1234),
+                20, 1.0, 0.5, 1234);
+        }
+    }
 }
 
 void OptimizersTest::testDifferentialEvolution() {
@@ -552,11 +623,192 @@ void OptimizersTest::testDifferentialEvolution() {
     }
 }
 
+void OptimizersTest::testBatchEvaluation() {
+    BOOST_TEST_MESSAGE("Testing batch evaluation in global optimizers...");
+
+    // the results must not depend on whether the population is
+    // evaluated concurrently or not
+    const char* names[] = { "differential evolution",
+                            "particle swarm optimization",
+                            "firefly algorithm" };
+    Griewangk serial;
+    ConcurrentGriewangk concurrent;
+    BoundaryConstraint constraint(-600.0, 600.0);
+    EndCriteria endCriteria(100, 50, 1e-8, 1e-8, Null<Real>());
+
+    for (Size i = 0; i < 3; ++i) {
+        Problem problem(serial, constraint, Array(5, 100.0));
+        makeGlobalOptimizer(i)->minimize(problem, endCriteria);
+        Problem concurrentProblem(concurrent, constraint, Array(5, 100.0));
+        makeGlobalOptimizer(i)->minimize(concurrentProblem, endCriteria);
+
+        if (problem.functionValue() != concurrentProblem.functionValue())
+            BOOST_ERROR("failed to reproduce " << names[i]
+                        << " results with concurrent evaluation"
+                        << "\n    serial:     " << problem.functionValue()
+                        << "\n    concurrent: "
+                        << concurrentProblem.functionValue());
+        for (Size j = 0; j < 5; ++j) {
+            if (problem.currentValue()[j]
+                != concurrentProblem.currentValue()[j])
+                BOOST_ERROR("failed to reproduce " << names[i]
+                            << " minimum with concurrent evaluation"
+                            << "\n    serial:     "
+                            << problem.currentValue()
+                            << "\n    concurrent: "
+                            << concurrentProblem.currentValue());
+        }
+    }
+}
+
+void OptimizersTest::testMultiStartLevenbergMarquardt() {
+    BOOST_TEST_MESSAGE("Testing multi-start Levenberg-Marquardt...");
+
+    BoundaryConstraint constraint(-2.0, 2.0);
+    EndCriteria endCriteria(1000, 100, 1e-12, 1e-12, 1e-12);
+    Array initialValue(2);
+    initialValue[0] = 1.7;
+    initialValue[1] = -1.6;
+
+    // a single local run gets stuck close to (2, -2)
+    LatticeLeastSquares serial(false), concurrent(true);
+    Problem localProblem(serial, constraint, initialValue);
+    LevenbergMarquardt().minimize(localProblem, endCriteria);
+    if (localProblem.functionValue() < 1.0)
+        BOOST_ERROR("local optimizer unexpectedly found the global minimum"
+                    << "\n    minimum: " << localProblem.currentValue()
+                    << "\n    value:   " << localProblem.functionValue());
+
+    Problem problem(serial, constraint, initialValue);
+    MultiStartLevenbergMarquardt multiStart(50, 42);
+    multiStart.minimize(problem, endCriteria);
+
+    const Real tolerance = 1e-8;
+    if (problem.functionValue() > tolerance
+        || std::fabs(problem.currentValue()[0]) > tolerance
+        || std::fabs(problem.currentValue()[1]) > tolerance)
+        BOOST_ERROR("failed to find the global minimum"
+                    << "\n    minimum: " << problem.currentValue()
+                    << "\n    value:   " << problem.functionValue());
+
+    if (multiStart.functionValues().size() != 51
+        || multiStart.functionValues().front()
+               != localProblem.functionValue())
+        BOOST_ERROR("unexpected local minima");
+
+    // the evaluations of all runs are counted
+    if (problem.functionEvaluation() <= localProblem.functionEvaluation())
+        BOOST_ERROR("evaluations of the additional runs not counted"
+                    << "\n    multi-start: " << problem.functionEvaluation()
+                    << "\n    single run:  "
+                    << localProblem.functionEvaluation());
+
+    // concurrent runs give the same result
+    Problem concurrentProblem(concurrent, constraint, initialValue);
+    MultiStartLevenbergMarquardt concurrentMultiStart(50, 42);
+    concurrentMultiStart.minimize(concurrentProblem, endCriteria);
+    for (Size i = 0; i < multiStart.functionValues().size(); ++i) {
+        if (multiStart.functionValues()[i]
+            != concurrentMultiStart.functionValues()[i])
+            BOOST_ERROR("failed to reproduce run #" << i
+                        << " concurrently"
+                        << "\n    serial:     "
+                        << multiStart.functionValues()[i]
+                        << "\n    concurrent: "
+                        << concurrentMultiStart.functionValues()[i]);
+    }
+    if (concurrentProblem.functionEvaluation()
+        != problem.functionEvaluation())
+        BOOST_ERROR("failed to reproduce number of evaluations concurrently"
+                    << "\n    serial:     " << problem.functionEvaluation()
+                    << "\n    concurrent: "
+                    << concurrentProblem.functionEvaluation());
+}
+
+void OptimizersTest::testBatchLevenbergMarquardt() {
+    BOOST_TEST_MESSAGE("Testing Levenberg-Marquardt on batches of problems...");
+
+    // many small problems with the same shape
+    const Size nProblems = 50, nData = 12;
+    std::vector<ext::shared_ptr<CostFunction> > serialFits, concurrentFits;
+    for (Size k = 0; k < nProblems; ++k) {
+        Array data(nData);
+        for (Size i = 0; i < nData; ++i)
+            data[i] = (1.0 + 0.02*k)*std::exp(-(0.3 + 0.01*k)*0.5*i)
+                    + 0.1 + 0.001*std::cos(3.0*i + k);
+        serialFits.push_back(ext::make_shared<ExponentialFit>(data, false));
+        concurrentFits.push_back(ext::make_shared<ExponentialFit>(data, true));
+    }
+
+    NoConstraint constraint;
+    Array initialValue(3, 0.5);
+    EndCriteria endCriteria(1000, 100, 1e-12, 1e-12, 1e-12);
+
+    // reference: a new optimizer for each problem
+    std::vector<Array> expected;
+    std::vector<Integer> evaluations;
+    for (Size k = 0; k < nProblems; ++k) {
+        Problem problem(*serialFits[k], constraint, initialValue);
+        LevenbergMarquardt().minimize(problem, endCriteria);
+        expected.push_back(problem.currentValue());
+        evaluations.push_back(problem.functionEvaluation());
+    }
+
+    for (Size j = 0; j < 4; ++j) {
+        std::vector<ext::shared_ptr<CostFunction> >& fits =
+            j % 2 == 0 ? serialFits : concurrentFits;
+        std::vector<ext::shared_ptr<Problem> > problems;
+        for (Size k = 0; k < nProblems; ++k)
+            problems.push_back(ext::make_shared<Problem>(
+                ext::ref(*fits[k]), ext::ref(constraint), initialValue));
+
+        LevenbergMarquardt optimizer;
+        if (j < 2) {
+            // one optimizer reused, with the jacobian columns
+            // evaluated concurrently if possible
+            optimizer.enableParallelJacobian();
+            for (Size k = 0; k < nProblems; ++k)
+                optimizer.minimize(*problems[k], endCriteria);
+        } else {
+            // the setting must be passed to the optimizers used by
+            // each thread
+            optimizer.enableParallelJacobian(j == 3);
+            optimizer.minimize(problems, endCriteria);
+        }
+
+        for (Size k = 0; k < nProblems; ++k) {
+            for (Size i = 0; i < 3; ++i) {
+                if (problems[k]->currentValue()[i] != expected[k][i])
+                    BOOST_ERROR("failed to reproduce minimum of problem #"
+                                << k << " in scenario #" << j
+                                << "\n    calculated: "
+                                << problems[k]->currentValue()
+                                << "\n    expected:   " << expected[k]);
+            }
+            // the evaluations for the jacobian must be counted, too;
+            // the parallel jacobian might need an additional one
+            // after rejected steps
+            if (problems[k]->functionEvaluation() < evaluations[k])
+                BOOST_ERROR("missing function evaluations for problem #"
+                            << k << " in scenario #" << j
+                            << "\n    calculated: "
+                            << problems[k]->functionEvaluation()
+                            << "\n    expected:   at least "
+                            << evaluations[k]);
+        }
+    }
+}
+
 test_suite* OptimizersTest::suite(SpeedLevel speed) {
     test_suite* suite = BOOST_TEST_SUITE("Optimizers tests");
 
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::test));
     suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::nestedOptimizationTest));
+    suite->add(QUANTLIB_TEST_CASE(&OptimizersTest::testBatchEvaluation));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OptimizersTest::testMultiStartLevenbergMarquardt));
+    suite->add(QUANTLIB_TEST_CASE(
+        &OptimizersTest::testBatchLevenbergMarquardt));
 
     if (speed <= Fast) {
         suite->add(QUANTLIB_TEST_CASE(
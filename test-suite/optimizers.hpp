@@ -30,6 +30,9 @@ class OptimizersTest {
     static void test();
     static void nestedOptimizationTest();
     static void testDifferentialEvolution();
+    static void testBatchEvaluation();
+    static void testMultiStartLevenbergMarquardt();
+    static void testBatchLevenbergMarquardt();
     static boost::unit_test_framework::test_suite* suite(SpeedLevel);
 };
 
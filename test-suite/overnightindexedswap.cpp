@@ -36,6 +36,7 @@
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/indexes/ibor/fedfunds.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/cashflows/overnightindexedcoupon.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/couponpricer.hpp>
@@ -134,6 +135,7 @@ namespace {
 
         // cleanup
         SavedSettings backup;
+        IndexHistoryCleaner indexCleaner;
 
         // utilities
         shared_ptr<OvernightIndexedSwap> makeSwap(Period length,
@@ -175,6 +177,28 @@ namespace {
         }
     };
 
+
+    Rate expectedCouponRate(const OvernightIndexedCoupon& coupon,
+                            const Handle<YieldTermStructure>& curve) {
+        // straightforward compounding of past fixings
+        const std::vector<Date>& fixingDates = coupon.fixingDates();
+        const std::vector<Date>& valueDates = coupon.valueDates();
+        const std::vector<Time>& dt = coupon.dt();
+        const TimeSeries<Real>& fixings =
+            coupon.index()->timeSeries();
+        Date today = Settings::instance().evaluationDate();
+        Size i = 0, n = dt.size();
+        Real compoundFactor = 1.0;
+        while (i < n && fixingDates[i] < today) {
+            compoundFactor *= 1.0 + fixings[fixingDates[i]] * dt[i];
+            ++i;
+        }
+        if (i < n)
+            compoundFactor *= curve->discount(valueDates[i])
+                            / curve->discount(valueDates[n]);
+        return (compoundFactor - 1.0) / coupon.accrualPeriod();
+    }
+
 }
 
 
@@ -497,6 +521,81 @@ void OvernightIndexedSwapTest::testBootstrapRegression() {
 }
 
 
+void OvernightIndexedSwapTest::testCompoundedPastFixings() {
+    BOOST_TEST_MESSAGE("Testing compounding of past overnight fixings...");
+
+    CommonVars vars;
+
+    const Calendar& calendar = vars.eoniaIndex->fixingCalendar();
+    Date firstFixing(2, January, 2008);
+    Size k = 0;
+    for (Date d = firstFixing; d < vars.today;
+         d = calendar.advance(d, 1, Days), ++k)
+        vars.eoniaIndex->addFixing(d, 0.02 + 0.0001*(k % 17));
+
+    Date startDates[] = {
+        Date(2, January, 2008), Date(15, March, 2008),
+        Date(31, October, 2008), Date(2, February, 2009),
+        Date(5, February, 2009)
+    };
+    std::vector<ext::shared_ptr<OvernightIndexedCoupon> > coupons;
+    for (Size i=0; i<LENGTH(startDates); ++i) {
+        Date end = calendar.advance(vars.today, 3*Months);
+        coupons.push_back(ext::make_shared<OvernightIndexedCoupon>(
+                            end, 100.0, startDates[i], end, vars.eoniaIndex));
+        // a coupon entirely in the past
+        if (i < 3) {
+            end = calendar.advance(startDates[i], 1*Months);
+            coupons.push_back(ext::make_shared<OvernightIndexedCoupon>(
+                            end, 100.0, startDates[i], end, vars.eoniaIndex));
+        }
+    }
+
+    const std::vector<Date>& fixingDates = coupons[0]->fixingDates();
+    if (vars.eoniaIndex->compoundFactor(fixingDates[0], fixingDates[9], 10)
+                                                          == Null<Real>())
+        BOOST_ERROR("compounded fixings not available");
+    if (vars.eoniaIndex->compoundFactor(fixingDates[0], fixingDates[9], 9)
+                                                          != Null<Real>())
+        BOOST_ERROR("compounded fixings available for inconsistent dates");
+    // indexes with the same name share the cached factors
+    ext::shared_ptr<OvernightIndex> clone =
+        ext::dynamic_pointer_cast<OvernightIndex>(
+            vars.eoniaIndex->clone(Handle<YieldTermStructure>()));
+    if (clone->compoundFactor(fixingDates[0], fixingDates[9], 10) !=
+        vars.eoniaIndex->compoundFactor(fixingDates[0], fixingDates[9], 10))
+        BOOST_ERROR("compounded fixings differ for a clone of the index");
+
+    Real tolerance = 1.0e-12;
+    for (Size step=0; step<3; ++step) {
+        for (Size i=0; i<coupons.size(); ++i) {
+            Rate calculated = coupons[i]->rate();
+            Rate expected = expectedCouponRate(*coupons[i],
+                                               vars.eoniaTermStructure);
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("failed to reproduce coupon rate"
+                            << std::setprecision(12)
+                            << "\n    accrual start: "
+                            << coupons[i]->accrualStartDate()
+                            << "\n    accrual end:   "
+                            << coupons[i]->accrualEndDate()
+                            << "\n    calculated:    " << calculated
+                            << "\n    expected:      " << expected);
+        }
+
+        if (step == 0) {
+            // the cached factors must follow changes in the fixings
+            vars.eoniaIndex->addFixing(Date(3, November, 2008), 0.04, true);
+        } else if (step == 1) {
+            vars.eoniaIndex->clearFixings();
+            k = 0;
+            for (Date d = firstFixing; d < vars.today;
+                 d = calendar.advance(d, 1, Days), ++k)
+                vars.eoniaIndex->addFixing(d, 0.01 + 0.0002*(k % 7));
+        }
+    }
+}
+
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
@@ -507,5 +606,7 @@ test_suite* OvernightIndexedSwapTest::suite() {
         &OvernightIndexedSwapTest::testBootstrapWithTelescopicDates));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testSeasonedSwaps));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testBootstrapRegression));
+    suite->add(QUANTLIB_TEST_CASE(
+                         &OvernightIndexedSwapTest::testCompoundedPastFixings));
     return suite;
 }
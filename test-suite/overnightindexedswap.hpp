@@ -35,6 +35,7 @@ class OvernightIndexedSwapTest {
     static void testBootstrapWithTelescopicDates();
     static void testSeasonedSwaps();
     static void testBootstrapRegression();
+    static void testCompoundedPastFixings();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -91,12 +91,76 @@ void RngTraitsTest::testCustomPoisson() {
                    << "    expected:   " << stored);
 }
 
+void RngTraitsTest::testCounterBased() {
+
+    BOOST_TEST_MESSAGE("Testing counter-based pseudo-random number generation...");
+
+    // known-answer values from the Random123 distribution
+    boost::uint32_t counters[][4] = {
+        { 0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U },
+        { 0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU },
+        { 0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U } };
+    boost::uint32_t keys[][2] = {
+        { 0x00000000U, 0x00000000U },
+        { 0xffffffffU, 0xffffffffU },
+        { 0xa4093822U, 0x299f31d0U } };
+    boost::uint32_t expected[][4] = {
+        { 0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U },
+        { 0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU },
+        { 0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U } };
+
+    for (Size i=0; i<LENGTH(counters); ++i) {
+        boost::uint32_t output[4];
+        Philox4x32UniformRng::philox(counters[i], keys[i], output);
+        for (Size j=0; j<4; ++j) {
+            if (output[j] != expected[i][j])
+                BOOST_FAIL("Philox-4x32-10 output does not match "
+                           "known-answer value"
+                           << "\n    test:       " << i
+                           << "\n    word:       " << j
+                           << "\n    calculated: " << output[j]
+                           << "\n    expected:   " << expected[i][j]);
+        }
+    }
+
+    // skipping to a path reproduces the sequential draws
+    Size dimension = 17;
+    BigNatural seed = 1234;
+    CounterBasedPseudoRandom::rsg_type rsg1 =
+        CounterBasedPseudoRandom::make_sequence_generator(dimension, seed);
+    CounterBasedPseudoRandom::rsg_type rsg2 =
+        CounterBasedPseudoRandom::make_sequence_generator(dimension, seed);
+
+    Size paths[] = { 0, 1, 5, 42, 1000 };
+    Size path = 0;
+    for (Size k=0; k<LENGTH(paths); ++k) {
+        for (; path<paths[k]; ++path)
+            rsg1.nextSequence();
+        const std::vector<Real>& x1 = rsg1.nextSequence().value;
+        ++path;
+
+        rsg2.skipTo(paths[k]);
+        const std::vector<Real>& x2 = rsg2.nextSequence().value;
+
+        for (Size j=0; j<dimension; ++j) {
+            if (x1[j] != x2[j])
+                BOOST_FAIL("skipping to a path does not reproduce "
+                           "the sequential draws"
+                           << "\n    path:       " << paths[k]
+                           << "\n    dimension:  " << j
+                           << "\n    sequential: " << x1[j]
+                           << "\n    skipped:    " << x2[j]);
+        }
+    }
+}
+
 
 test_suite* RngTraitsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("RNG traits tests");
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testGaussian));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testDefaultPoisson));
     suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCustomPoisson));
+    suite->add(QUANTLIB_TEST_CASE(&RngTraitsTest::testCounterBased));
     return suite;
 }
 
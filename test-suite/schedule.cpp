@@ -20,6 +20,7 @@
 #include "schedule.hpp"
 #include "utilities.hpp"
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -550,6 +551,92 @@ void ScheduleTest::testTruncation() {
     BOOST_CHECK(t.isRegular().front() == true);
 }
 
+void ScheduleTest::testScheduleCache() {
+    BOOST_TEST_MESSAGE("Testing schedule cache...");
+
+    ScheduleCache::instance().clear();
+
+    MakeSchedule make = MakeSchedule()
+        .from(Date(15, March, 2019))
+        .to(Date(15, March, 2029))
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(ModifiedFollowing)
+        .cached();
+
+    Schedule s1 = make;
+    Schedule s2 = make;
+    Schedule s3 = MakeSchedule(make).cached(false);
+
+    if (ScheduleCache::instance().size() != 1)
+        BOOST_ERROR("unexpected number of cached schedules: "
+                    << ScheduleCache::instance().size()
+                    << " (expected 1)");
+    if (&s1.dates() != &s2.dates())
+        BOOST_ERROR("schedules with the same parameters don't share dates");
+    if (&s1.dates() == &s3.dates())
+        BOOST_ERROR("uncached schedule shares dates with cached one");
+    check_dates(s1, s3.dates());
+
+    // truncating doesn't modify the cached dates
+    Schedule t = s1.after(Date(1, January, 2025));
+    check_dates(s2, s3.dates());
+    if (t.size() >= s2.size())
+        BOOST_ERROR("truncated schedule not shorter than original");
+
+    Schedule s4 = MakeSchedule(make).withTenor(3*Months);
+    if (ScheduleCache::instance().size() != 2)
+        BOOST_ERROR("unexpected number of cached schedules: "
+                    << ScheduleCache::instance().size()
+                    << " (expected 2)");
+    if (&s1.dates() == &s4.dates())
+        BOOST_ERROR("schedules with different tenors share dates");
+
+    // adding a holiday discards the stored schedules
+    Date holiday = s1[2];
+    Calendar target = TARGET();
+    target.addHoliday(holiday);
+    Schedule s5 = make;
+    target.removeHoliday(holiday);
+    if (&s1.dates() == &s5.dates())
+        BOOST_ERROR("schedule not regenerated after holiday change");
+    if (s5[2] == holiday)
+        BOOST_ERROR("added holiday " << holiday << " used as schedule date");
+    Schedule s6 = make;
+    check_dates(s6, s3.dates());
+
+    // changes to other calendars keep the stored schedules
+    Calendar other = UnitedStates();
+    other.addHoliday(holiday);
+    Schedule s7 = make;
+    other.removeHoliday(holiday);
+    if (&s6.dates() != &s7.dates())
+        BOOST_ERROR("schedule regenerated after changes to another calendar");
+
+    // the oldest schedules are discarded when the cache is full
+    Size maxSize = ScheduleCache::instance().maxSize();
+    ScheduleCache::instance().clear();
+    ScheduleCache::instance().setMaxSize(2);
+    Schedule a1 = MakeSchedule(make).withTenor(1*Years);
+    Schedule a2 = MakeSchedule(make).withTenor(2*Years);
+    Schedule a3 = MakeSchedule(make).withTenor(5*Years);
+    Schedule b2 = MakeSchedule(make).withTenor(2*Years);
+    Schedule b1 = MakeSchedule(make).withTenor(1*Years);
+    ScheduleCache::instance().setMaxSize(maxSize);
+    if (&a2.dates() != &b2.dates())
+        BOOST_ERROR("recent schedule discarded from cache");
+    if (&a1.dates() == &b1.dates())
+        BOOST_ERROR("oldest schedule not discarded from cache");
+
+    ScheduleCache::instance().clear();
+    if (ScheduleCache::instance().size() != 0)
+        BOOST_ERROR("schedule cache not cleared");
+
+    Schedule empty;
+    if (!empty.empty() || empty.size() != 0)
+        BOOST_ERROR("default-constructed schedule not empty");
+}
+
 test_suite* ScheduleTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Schedule tests");
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testDailySchedule));
@@ -572,5 +659,6 @@ test_suite* ScheduleTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testFirstDateOnMaturity));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testNextToLastDateOnStart));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testTruncation));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testScheduleCache));
     return suite;
 }
@@ -442,6 +442,178 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testBatchCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing batch calibration of sabr swaption cube...");
+
+    CommonVars vars;
+
+    const Size nOptions = vars.cube.tenors.options.size();
+    const Size nSwaps = vars.cube.tenors.swaps.size();
+    const Size nStrikes = vars.cube.strikeSpreads.size();
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(nOptions*nSwaps);
+    for (Size i=0; i<nOptions*nSwaps; i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    ext::shared_ptr<SwaptionVolCube1> volCube[2];
+    for (Size n=0; n<2; ++n) {
+        volCube[n] = ext::make_shared<SwaptionVolCube1>(
+                                                vars.atmVolMatrix,
+                                                vars.cube.tenors.options,
+                                                vars.cube.tenors.swaps,
+                                                vars.cube.strikeSpreads,
+                                                vars.cube.volSpreadsHandle,
+                                                vars.swapIndexBase,
+                                                vars.shortSwapIndexBase,
+                                                vars.vegaWeighedSmileFit,
+                                                parametersGuess,
+                                                isParameterFixed,
+                                                true);
+    }
+    volCube[1]->enableBatchCalibration();
+
+    const Size changedNode = nSwaps + 1;
+    const Real tolerance[2] = { 1.0e-12, 1.0e-5 };
+    for (Size scenario=0; scenario<2; ++scenario) {
+        if (scenario == 1) {
+            // move the quotes of a single node
+            for (Size k=0; k<nStrikes; ++k) {
+                ext::shared_ptr<SimpleQuote> q =
+                    ext::dynamic_pointer_cast<SimpleQuote>(
+                       vars.cube.volSpreadsHandle[changedNode][k].currentLink());
+                q->setValue(q->value() + 0.0010);
+            }
+        }
+
+        const std::vector<SwaptionVolCube1::NodeCalibration>& diagnostics =
+            volCube[1]->sparseCalibrationDiagnostics();
+        if (diagnostics.size() != nOptions*nSwaps)
+            BOOST_FAIL("wrong number of calibration diagnostics: "
+                       << diagnostics.size() << " instead of "
+                       << nOptions*nSwaps);
+        for (Size n=0; n<diagnostics.size(); ++n) {
+            const bool expected = (scenario == 0 || n == changedNode);
+            if (diagnostics[n].recalibrated != expected
+                || diagnostics[n].warmStarted != (scenario == 1 && expected))
+                BOOST_ERROR("unexpected calibration of node " << n
+                            << " in scenario " << scenario
+                            << "\n    recalibrated: "
+                            << diagnostics[n].recalibrated
+                            << "\n    warm-started: "
+                            << diagnostics[n].warmStarted);
+            if (diagnostics[n].endCriteria == EndCriteria::MaxIterations)
+                BOOST_ERROR("calibration of node " << n
+                            << " reached the maximum number of iterations");
+        }
+
+        Rate dummyStrike = 0.03;
+        for (Size i=0; i<nOptions; i++) {
+            for (Size j=0; j<nSwaps; j++) {
+                for (Size k=0; k<nStrikes; k++) {
+                    Rate strike = dummyStrike + vars.cube.strikeSpreads[k];
+                    Volatility expected = volCube[0]->volatility(
+                                                vars.cube.tenors.options[i],
+                                                vars.cube.tenors.swaps[j],
+                                                strike, false);
+                    Volatility calculated = volCube[1]->volatility(
+                                                vars.cube.tenors.options[i],
+                                                vars.cube.tenors.swaps[j],
+                                                strike, false);
+                    if (std::fabs(calculated - expected) > tolerance[scenario])
+                        BOOST_ERROR("batch calibration doesn't reproduce "
+                                    "serial calibration"
+                                    << "\n    scenario:    " << scenario
+                                    << "\n    option:      "
+                                    << vars.cube.tenors.options[i]
+                                    << "\n    swap:        "
+                                    << vars.cube.tenors.swaps[j]
+                                    << "\n    strike:      "
+                                    << io::rate(strike)
+                                    << "\n    serial:      "
+                                    << io::volatility(expected)
+                                    << "\n    batch:       "
+                                    << io::volatility(calculated)
+                                    << "\n    error:       "
+                                    << std::fabs(calculated - expected)
+                                    << "\n    tolerance:   "
+                                    << tolerance[scenario]);
+                }
+            }
+        }
+    }
+}
+
+void SwaptionVolatilityCubeTest::testCalibrationFailure() {
+
+    BOOST_TEST_MESSAGE("Testing failures in sabr swaption cube calibration...");
+
+    CommonVars vars;
+
+    const Size nOptions = vars.cube.tenors.options.size();
+    const Size nSwaps = vars.cube.tenors.swaps.size();
+
+    // an invalid fixed beta makes the fit of a single node fail
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(nOptions*nSwaps);
+    for (Size i=0; i<nOptions*nSwaps; i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(ext::shared_ptr<Quote>(
+                           new SimpleQuote(i == nSwaps + 1 ? 1.5 : 0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(ext::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+    isParameterFixed[1] = true;
+
+    for (Size n=0; n<2; ++n) {
+        ext::shared_ptr<SwaptionVolCube1> volCube =
+            ext::make_shared<SwaptionVolCube1>(vars.atmVolMatrix,
+                                               vars.cube.tenors.options,
+                                               vars.cube.tenors.swaps,
+                                               vars.cube.strikeSpreads,
+                                               vars.cube.volSpreadsHandle,
+                                               vars.swapIndexBase,
+                                               vars.shortSwapIndexBase,
+                                               vars.vegaWeighedSmileFit,
+                                               parametersGuess,
+                                               isParameterFixed,
+                                               true);
+        if (n == 1)
+            volCube->enableBatchCalibration();
+
+        // the failure must be reported as an exception, with or
+        // without batch calibration and whether or not OpenMP is used
+        bool thrown = false;
+        try {
+            volCube->volatility(vars.cube.tenors.options[0],
+                                vars.cube.tenors.swaps[0], 0.03, false);
+        } catch (Error&) {
+            thrown = true;
+        }
+        if (!thrown)
+            BOOST_ERROR("failed calibration not reported"
+                        << (n == 1 ? " with" : " without")
+                        << " batch calibration");
+    }
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -459,5 +631,10 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(
                              &SwaptionVolatilityCubeTest::testObservability));
 
+    suite->add(QUANTLIB_TEST_CASE(
+                          &SwaptionVolatilityCubeTest::testBatchCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &SwaptionVolatilityCubeTest::testCalibrationFailure));
+
     return suite;
 }
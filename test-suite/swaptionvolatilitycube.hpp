@@ -33,6 +33,8 @@ class SwaptionVolatilityCubeTest {
     static void testSabrVols();
     static void testSpreadedCube();
     static void testObservability();
+    static void testBatchCalibration();
+    static void testCalibrationFailure();
 
     static boost::unit_test_framework::test_suite* suite();
 };
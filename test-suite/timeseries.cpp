@@ -21,8 +21,14 @@
 #include "timeseries.hpp"
 #include "utilities.hpp"
 #include <ql/timeseries.hpp>
+#include <ql/utilities/marketdatasnapshot.hpp>
+#include <ql/indexes/indexmanager.hpp>
 #include <ql/prices.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -38,6 +44,20 @@
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
+namespace {
+
+    // removes the file when going out of scope, even if a test fails
+    class TemporaryFile {
+      public:
+        explicit TemporaryFile(const std::string& name) : name_(name) {}
+        ~TemporaryFile() { std::remove(name_.c_str()); }
+        const std::string& name() const { return name_; }
+      private:
+        std::string name_;
+    };
+
+}
+
 void TimeSeriesTest::testConstruction() {
 
     BOOST_TEST_MESSAGE("Testing time series construction...");
@@ -193,11 +213,114 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testSnapshot() {
+    BOOST_TEST_MESSAGE("Testing market-data snapshots...");
+
+    IndexHistoryCleaner cleaner;
+
+    std::map<std::string, TimeSeries<Real> > fixings;
+    TimeSeries<Real>& euribor = fixings["Euribor6M"];
+    Date d = Date(2, January, 2018);
+    for (Size i=0; i<250; ++i, d += 3)
+        euribor[d] = -0.003 + i*1.0e-5;
+    TimeSeries<Real>& eonia = fixings["Eonia"];
+    eonia[Date(15, June, 2019)] = -0.0036;
+    // an empty history is stored as well
+    fixings["USDLibor3M"] = TimeSeries<Real>();
+
+    std::map<std::string, Real> quotes;
+    quotes["EUR.SWAP.10Y"] = 0.0042;
+    quotes["EUR.SWAP.30Y"] = 0.0087;
+
+    const TemporaryFile file("quantlib-test-snapshot.bin");
+    const std::string& filename = file.name();
+    MarketDataSnapshot::save(filename, fixings, quotes);
+
+    {
+        MarketDataSnapshot snapshot(filename);
+
+        std::vector<std::string> names = snapshot.fixingNames();
+        if (names.size() != 3 || names[0] != "EONIA"
+            || names[1] != "EURIBOR6M" || names[2] != "USDLIBOR3M")
+            BOOST_ERROR("wrong fixing names in snapshot");
+        if (!snapshot.hasFixings("euribor6m"))
+            BOOST_ERROR("fixing lookup is not case-insensitive");
+
+        MarketDataSnapshot::Fixings f = snapshot.fixings("Euribor6M");
+        if (f.size() != euribor.size())
+            BOOST_ERROR("wrong number of fixings: " << f.size()
+                        << " instead of " << euribor.size());
+        if (f.firstDate() != euribor.firstDate()
+            || f.lastDate() != euribor.lastDate())
+            BOOST_ERROR("wrong fixing dates");
+        const TimeSeries<Real>& ceuribor = euribor;
+        for (Date day = euribor.firstDate() - 2;
+             day <= euribor.lastDate() + 2; ++day) {
+            if (f[day] != ceuribor[day])
+                BOOST_ERROR("fixing does not match at " << day << ": "
+                            << f[day] << " instead of " << ceuribor[day]);
+        }
+        if (!snapshot.fixings("USDLibor3M").empty())
+            BOOST_ERROR("empty history not preserved");
+
+        if (snapshot.quoteNames().size() != 2
+            || snapshot.quote("EUR.SWAP.10Y") != 0.0042
+            || snapshot.quote("EUR.SWAP.30Y") != 0.0087)
+            BOOST_ERROR("quotes not preserved");
+        if (snapshot.hasQuote("EUR.SWAP.5Y"))
+            BOOST_ERROR("unexpected quote in snapshot");
+
+        snapshot.loadFixings();
+
+        // the view keeps the mapping alive after the snapshot is gone
+        MarketDataSnapshot::Fixings g =
+            MarketDataSnapshot(filename).fixings("Eonia");
+        if (g.size() != 1 || g.value(0) != -0.0036)
+            BOOST_ERROR("fixing view not preserved");
+    }
+
+    const TimeSeries<Real>& loaded =
+        IndexManager::instance().getHistory("EURIBOR6M");
+    if (loaded.size() != euribor.size())
+        BOOST_ERROR("wrong number of loaded fixings: " << loaded.size()
+                    << " instead of " << euribor.size());
+    for (TimeSeries<Real>::const_iterator i = euribor.cbegin();
+         i != euribor.cend(); ++i) {
+        if (loaded[i->first] != i->second)
+            BOOST_ERROR("loaded fixing does not match at " << i->first);
+    }
+
+    // corrupted sizes and offsets are detected, even when adding
+    // them would overflow
+    std::string contents;
+    {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(in),
+                        std::istreambuf_iterator<char>());
+    }
+    const boost::uint64_t huge = ~boost::uint64_t(0) / 32 + 2;
+    // nSeries (after the magic), offset of the first series data,
+    // and size of the first series
+    const std::size_t offsets[] = { 8, 24 + 16, 24 + 24 };
+    const TemporaryFile corruptedFile("quantlib-test-snapshot-bad.bin");
+    for (Size i=0; i<LENGTH(offsets); ++i) {
+        std::string corrupted = contents;
+        std::memcpy(&corrupted[offsets[i]], &huge, sizeof(huge));
+        {
+            std::ofstream out(corruptedFile.name().c_str(),
+                              std::ios::binary | std::ios::trunc);
+            out.write(corrupted.data(), std::streamsize(corrupted.size()));
+        }
+        BOOST_CHECK_THROW(MarketDataSnapshot(corruptedFile.name()), Error);
+    }
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testSnapshot));
     return suite;
 }
 